@@ -1,8 +1,10 @@
 #ifndef CALLISTO_BUDDY_HPP_
 #define CALLISTO_BUDDY_HPP_
 #include <AllocatorBase.hpp>
+#include <DefragmentationMove.hpp>
 #include <ranges>
 #include <algorithm>
+#include <span>
 
 class TestBuddy;
 
@@ -12,7 +14,16 @@ class Buddy : public AllocatorBase
 {
 	friend ::TestBuddy;
 public:
+	// The buddy doesn't keep track of the allocated blocks, so they must be supplied for
+	// the defragmentation.
+	struct LiveAllocation
+	{
+		size_t startingAddress;
+		size_t size;
+		size_t alignment;
+	};
 
+public:
 	Buddy(size_t startingAddress, size_t totalSize, size_t minimumBlockSize);
 	Buddy(
 		size_t startingAddress, size_t totalSize, size_t defaultAlignment, size_t minimumBlockSize
@@ -55,6 +66,16 @@ public:
 	[[nodiscard]]
 	static size_t GetMinimumRequiredNewAllocationSizeFor(size_t size) noexcept;
 
+	[[nodiscard]]
+	// Tries to move the allocations with the highest addresses to the free blocks with lower
+	// addresses, so the free blocks on the top can be merged. The startingAddress of the moved
+	// allocations will be updated. The old blocks are only freed after every move has been
+	// planned, so none of the moves overlap with each other and they can be executed in any
+	// order. The allocations which don't fit in the rest of the byteBudget are skipped.
+	std::vector<DefragmentationMove> Defragment(
+		std::span<LiveAllocation> liveAllocations, size_t byteBudget
+	) noexcept;
+
 private:
 	void InitInitialAvailableBlocks(size_t startingAddress, size_t totalSize) noexcept;
 
@@ -81,6 +102,11 @@ private:
 	[[nodiscard]]
 	static size_t GetBuddyAddress(size_t buddyAddress, size_t blockSize) noexcept;
 
+private:
+	// The smaller blocks which are checked with their aligned size, before taking the first
+	// block which fits whatever its address is.
+	static constexpr size_t s_maxAlignedProbeCount = 8u;
+
 private:
 	size_t                   m_startingAddress;
 	size_t                   m_minimumBlockSize;
@@ -154,24 +180,26 @@ private:
 	std::optional<Buddy::AllocInfo64> FindAllocationBlock(
 		std::vector<Buddy::AllocInfo<T>>& blocks, size_t allocationSize, size_t allocationAlignment
 	) noexcept {
-		auto result = std::lower_bound(
-			std::begin(blocks), std::end(blocks), allocationSize,
-			[allocationAlignment, startingAddress = m_startingAddress]
-			(const AllocatorBase::AllocInfo<T>& info, size_t allocationSize)
-			{
-				const size_t blockSize             = info.size;
-				const size_t startingAddressOffset = info.startingAddress;
-				const size_t actualStartingAddress = startingAddressOffset + startingAddress;
-				const size_t alignedSize           = GetAlignedSize(
-					actualStartingAddress, allocationAlignment, allocationSize
-				);
-
-				return blockSize < alignedSize;
-			}
+		// The blocks are sorted by their size but the alignment padding depends on the address
+		// of a block, so the aligned sizes aren't sorted and can't be binary searched. But a
+		// block which is at least size + alignment - 1 fits wherever it is. So, only the first
+		// few smaller blocks are checked with their aligned size, and then the first block which
+		// surely fits is taken. Otherwise, many misaligned blocks of the same size would make
+		// every allocation linear. The remaining smaller blocks are only checked if there isn't
+		// any block which surely fits, so an allocation doesn't fail while a block fits.
+		auto sizeProjection = [](const AllocatorBase::AllocInfo<T>& info)
+		{
+			return static_cast<size_t>(info.size);
+		};
+
+		auto result = std::ranges::lower_bound(blocks, allocationSize, {}, sizeProjection);
+
+		const auto surelyFitsIt = std::ranges::lower_bound(
+			result, std::end(blocks), allocationSize + allocationAlignment - 1u, {}, sizeProjection
 		);
 
-		// If a result is found, it should be the required size or more. So, we can allocate in it.
-		if (result != std::end(blocks))
+		auto AllocateIfFits = [this, &result, allocationSize, allocationAlignment]
+			() noexcept -> std::optional<Buddy::AllocInfo64>
 		{
 			const AllocatorBase::AllocInfo<T>& info = *result;
 			const size_t blockSize                  = info.size;
@@ -181,13 +209,29 @@ private:
 				actualStartingAddress, allocationAlignment, allocationSize
 			);
 
+			if (blockSize < alignedSize)
+				return {};
+
 			RemoveIterator<T>(result);
+
 			return AllocateOnBlock(
 				startingAddressOffset, blockSize, allocationSize, allocationAlignment, alignedSize
 			);
-		}
-		else
-			return {};
+		};
+
+		for (size_t probeCount = 0u; result != surelyFitsIt && probeCount < s_maxAlignedProbeCount;
+			++result, ++probeCount)
+			if (std::optional<Buddy::AllocInfo64> allocInfo = AllocateIfFits(); allocInfo)
+				return allocInfo;
+
+		if (surelyFitsIt != std::end(blocks))
+			result = surelyFitsIt;
+
+		for (; result != std::end(blocks); ++result)
+			if (std::optional<Buddy::AllocInfo64> allocInfo = AllocateIfFits(); allocInfo)
+				return allocInfo;
+
+		return {};
 	}
 };
 }
@@ -0,0 +1,256 @@
+#ifndef CALLISTO_CONCURRENT_REUSABLE_VECTOR_HPP_
+#define CALLISTO_CONCURRENT_REUSABLE_VECTOR_HPP_
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <CallistoException.hpp>
+
+namespace Callisto
+{
+// A ReusableVector which can be added to and removed from by multiple threads. The availability
+// of the indices is kept in atomic 64bit words, where a set bit means the index is available,
+// and an index is claimed by unsetting its bit with fetch_and. The elements are stored in
+// segments, each of them twice the size of the previous one, which are never moved after they
+// have been allocated. So, adding and removing is lock-free unless a new segment must be
+// allocated, and operator[] is always lock-free.
+// Accessing an element while another thread is adding or removing the same index isn't safe.
+template<typename T, size_t firstSegmentSize = 1024u>
+class ConcurrentReusableVector
+{
+	static constexpr size_t s_bitsPerWord     = 64u;
+	// Enough segments to hold more elements than can be addressed.
+	static constexpr size_t s_maxSegmentCount = 48u;
+
+	static_assert(
+		std::has_single_bit(firstSegmentSize) && firstSegmentSize >= s_bitsPerWord,
+		"The first segment size must be a 2s exponent and at least 64."
+	);
+	static_assert(
+		firstSegmentSize <= (std::numeric_limits<size_t>::max() >> s_maxSegmentCount),
+		"The capacity of every segment wouldn't fit in a size_t."
+	);
+
+	struct Segment
+	{
+		std::unique_ptr<T[]>                          elements;
+		std::unique_ptr<std::atomic<std::uint64_t>[]> availableWords;
+	};
+
+public:
+	ConcurrentReusableVector()
+		: m_segments{}, m_segmentCount{ 0u }, m_searchWordHint{ 0u }, m_growthMutex{}
+	{}
+	ConcurrentReusableVector(size_t initialSize) : ConcurrentReusableVector{}
+	{
+		Resize(initialSize);
+	}
+
+	// Only grows the capacity, as the existing elements are never moved or freed. Throws if
+	// the count is more than every segment can hold.
+	void Resize(size_t newTotalCount)
+	{
+		if (newTotalCount > GetCapacity(s_maxSegmentCount))
+			throw Exception("AllocationError", "The count is more than every segment can hold.");
+
+		for (size_t segmentCount = m_segmentCount.load(std::memory_order_acquire);
+			GetCapacity(segmentCount) < newTotalCount;
+			segmentCount = m_segmentCount.load(std::memory_order_acquire))
+			AddSegment(segmentCount);
+	}
+
+	template<typename U>
+	// To use this, T must have a default ctor for the reserving. Throws if every segment is
+	// full.
+	size_t Add(U&& element)
+	{
+		while (true)
+		{
+			const size_t segmentCount    = m_segmentCount.load(std::memory_order_acquire);
+			std::optional<size_t> oIndex = ClaimAvailableIndex(segmentCount);
+
+			if (oIndex)
+			{
+				const size_t index = oIndex.value();
+
+				(*this)[index] = std::forward<U>(element);
+
+				return index;
+			}
+
+			// Another thread might have already added a segment. In that case, just search
+			// again.
+			AddSegment(segmentCount);
+		}
+	}
+
+	void RemoveElement(size_t index) noexcept
+	{
+		(*this)[index] = T{};
+		MakeUnavailable(index);
+	}
+
+	void MakeUnavailable(size_t index) noexcept
+	{
+		const size_t wordIndex  = index / s_bitsPerWord;
+		const std::uint64_t bit = std::uint64_t{ 1u } << (index % s_bitsPerWord);
+
+		// Release, so the reset element is visible to the thread which claims it next.
+		GetAvailableWord(wordIndex).fetch_or(bit, std::memory_order_release);
+
+		// Start the next search from here, as there is a free index. It is only a hint, so it
+		// doesn't matter if another thread changes it in between.
+		if (wordIndex < m_searchWordHint.load(std::memory_order_relaxed))
+			m_searchWordHint.store(wordIndex, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]]
+	bool IsInUse(size_t index) const noexcept
+	{
+		const std::uint64_t bit = std::uint64_t{ 1u } << (index % s_bitsPerWord);
+
+		return !(GetAvailableWord(index / s_bitsPerWord).load(std::memory_order_acquire) & bit);
+	}
+
+	T& operator[](size_t index) noexcept
+	{
+		const size_t segmentIndex = GetSegmentIndex(index);
+
+		return m_segments[segmentIndex].elements[index - GetCapacity(segmentIndex)];
+	}
+	const T& operator[](size_t index) const noexcept
+	{
+		const size_t segmentIndex = GetSegmentIndex(index);
+
+		return m_segments[segmentIndex].elements[index - GetCapacity(segmentIndex)];
+	}
+
+	[[nodiscard]]
+	size_t size() const noexcept
+	{
+		return GetCapacity(m_segmentCount.load(std::memory_order_acquire));
+	}
+
+private:
+	[[nodiscard]]
+	// The total number of elements in the first segmentCount segments.
+	static constexpr size_t GetCapacity(size_t segmentCount) noexcept
+	{
+		return firstSegmentSize * ((size_t{ 1u } << segmentCount) - 1u);
+	}
+
+	[[nodiscard]]
+	static constexpr size_t GetSegmentIndex(size_t index) noexcept
+	{
+		return static_cast<size_t>(std::bit_width(index / firstSegmentSize + 1u)) - 1u;
+	}
+
+	[[nodiscard]]
+	// Every segment has a multiple of 64 elements, so a word is never split between segments.
+	std::atomic<std::uint64_t>& GetAvailableWord(size_t wordIndex) const noexcept
+	{
+		const size_t index        = wordIndex * s_bitsPerWord;
+		const size_t segmentIndex = GetSegmentIndex(index);
+
+		return m_segments[segmentIndex].availableWords[
+			(index - GetCapacity(segmentIndex)) / s_bitsPerWord
+		];
+	}
+
+	[[nodiscard]]
+	std::optional<size_t> ClaimAvailableIndex(size_t segmentCount) noexcept
+	{
+		const size_t wordCount = GetCapacity(segmentCount) / s_bitsPerWord;
+
+		if (!wordCount)
+			return {};
+
+		const size_t firstWordIndex = m_searchWordHint.load(std::memory_order_relaxed) % wordCount;
+
+		for (size_t wordOffset = 0u; wordOffset < wordCount; ++wordOffset)
+		{
+			const size_t wordIndex           = (firstWordIndex + wordOffset) % wordCount;
+			std::atomic<std::uint64_t>& word = GetAvailableWord(wordIndex);
+
+			std::uint64_t availableBits      = word.load(std::memory_order_relaxed);
+
+			while (availableBits)
+			{
+				// The lowest set bit.
+				const std::uint64_t bit     = availableBits & (~availableBits + 1u);
+				const std::uint64_t oldBits = word.fetch_and(~bit, std::memory_order_acquire);
+
+				// If the bit was still set, this thread has claimed the index. Otherwise, another
+				// thread has claimed it first, so try the other available bits.
+				if (oldBits & bit)
+				{
+					m_searchWordHint.store(wordIndex, std::memory_order_relaxed);
+
+					return wordIndex * s_bitsPerWord + std::countr_zero(bit);
+				}
+
+				availableBits = oldBits & ~bit;
+			}
+		}
+
+		return {};
+	}
+
+	void AddSegment(size_t expectedSegmentCount)
+	{
+		std::scoped_lock growthLock{ m_growthMutex };
+
+		// Another thread has already added the segment.
+		if (m_segmentCount.load(std::memory_order_relaxed) != expectedSegmentCount)
+			return;
+
+		if (expectedSegmentCount >= s_maxSegmentCount)
+			throw Exception("AllocationError", "Can't add any more segments.");
+
+		const size_t segmentSize = firstSegmentSize << expectedSegmentCount;
+		const size_t wordCount   = segmentSize / s_bitsPerWord;
+
+		Segment& segment         = m_segments[expectedSegmentCount];
+
+		segment.elements         = std::make_unique<T[]>(segmentSize);
+		segment.availableWords   = std::make_unique<std::atomic<std::uint64_t>[]>(wordCount);
+
+		for (size_t wordIndex = 0u; wordIndex < wordCount; ++wordIndex)
+			segment.availableWords[wordIndex].store(~std::uint64_t{ 0u }, std::memory_order_relaxed);
+
+		// Release, so the new segment is visible to the threads which see the new count.
+		m_segmentCount.store(expectedSegmentCount + 1u, std::memory_order_release);
+	}
+
+private:
+	std::array<Segment, s_maxSegmentCount> m_segments;
+	std::atomic<size_t>                    m_segmentCount;
+	std::atomic<size_t>                    m_searchWordHint;
+	std::mutex                             m_growthMutex;
+
+public:
+	ConcurrentReusableVector(const ConcurrentReusableVector&) = delete;
+	ConcurrentReusableVector& operator=(const ConcurrentReusableVector&) = delete;
+
+	// Moving isn't thread-safe.
+	ConcurrentReusableVector(ConcurrentReusableVector&& other) noexcept
+		: m_segments{ std::move(other.m_segments) },
+		m_segmentCount{ other.m_segmentCount.exchange(0u) },
+		m_searchWordHint{ other.m_searchWordHint.exchange(0u) }, m_growthMutex{}
+	{}
+	ConcurrentReusableVector& operator=(ConcurrentReusableVector&& other) noexcept
+	{
+		m_segments = std::move(other.m_segments);
+		m_segmentCount.store(other.m_segmentCount.exchange(0u));
+		m_searchWordHint.store(other.m_searchWordHint.exchange(0u));
+
+		return *this;
+	}
+};
+}
+#endif
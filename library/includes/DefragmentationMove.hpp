@@ -0,0 +1,16 @@
+#ifndef CALLISTO_DEFRAGMENTATION_MOVE_HPP_
+#define CALLISTO_DEFRAGMENTATION_MOVE_HPP_
+#include <cstdint>
+
+namespace Callisto
+{
+// A copy which needs to be done to defragment a buffer. The source and the destination of a
+// single move never overlap, so each of them can be recorded as a buffer to buffer copy.
+struct DefragmentationMove
+{
+	size_t srcOffset;
+	size_t dstOffset;
+	size_t size;
+};
+}
+#endif
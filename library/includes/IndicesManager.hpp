@@ -1,38 +1,329 @@
 #ifndef CALLISTO_INDICES_MANAGER_HPP_
 #define CALLISTO_INDICES_MANAGER_HPP_
-#include <ranges>
+#include <cstdint>
+#include <cassert>
+#include <bit>
 #include <algorithm>
+#include <utility>
+#include <limits>
 #include <vector>
 #include <optional>
+#include <ranges>
+#include <iterator>
+#include <span>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
 
 namespace Callisto
 {
-class IndicesManager
+enum class FitPolicy
+{
+	// The first free range which is large enough.
+	FirstFit,
+	// The smallest free range which is large enough, so the larger ranges aren't fragmented.
+	BestFit
+};
+
+// The availability of the indices is stored as bits in 64bit words, where a set bit means the
+// index is available. Each bit of the summary words is set if the word with the same index has
+// any available index, so a free index can be found by checking one summary word for every
+// 4096 indices. The bits after the last index are always unset, so they are never found.
+// The words are allocated with the allocator, which will be rebound to std::uint64_t.
+template<typename Allocator_t = std::allocator<std::uint64_t>>
+class BasicIndicesManager
 {
+	static constexpr size_t s_bitsPerWord = 64u;
+
+	template<typename U>
+	using Rebind_t = std::allocator_traits<Allocator_t>::template rebind_alloc<U>;
+
+public:
+	using allocator_type = Rebind_t<std::uint64_t>;
+	using IndexVector_t  = std::vector<std::uint32_t, Rebind_t<std::uint32_t>>;
+
+	// The words from the first word to before the end word.
+	struct WordRange
+	{
+		size_t firstWordIndex;
+		size_t endWordIndex;
+	};
+
+private:
+	using WordVector_t   = std::vector<std::uint64_t, allocator_type>;
+
+public:
+	// Goes through the in use indices by jumping to the next set bit of the in use words.
+	class InUseIndexIterator
+	{
+	public:
+		using value_type      = size_t;
+		using difference_type = std::ptrdiff_t;
+
+		InUseIndexIterator() : m_indicesManager{ nullptr }, m_wordIndex{ 0u }, m_inUseBits{ 0u } {}
+		InUseIndexIterator(const BasicIndicesManager* indicesManager, size_t wordIndex)
+			: m_indicesManager{ indicesManager }, m_wordIndex{ wordIndex }, m_inUseBits{ 0u }
+		{
+			if (m_wordIndex < m_indicesManager->GetWordCount())
+				m_inUseBits = m_indicesManager->GetInUseWord(m_wordIndex);
+
+			SkipEmptyWords();
+		}
+
+		[[nodiscard]]
+		size_t operator*() const noexcept
+		{
+			return m_wordIndex * s_bitsPerWord + std::countr_zero(m_inUseBits);
+		}
+
+		InUseIndexIterator& operator++() noexcept
+		{
+			m_inUseBits &= m_inUseBits - 1u;
+
+			SkipEmptyWords();
+
+			return *this;
+		}
+		InUseIndexIterator operator++(int) noexcept
+		{
+			InUseIndexIterator previous = *this;
+
+			++(*this);
+
+			return previous;
+		}
+
+		[[nodiscard]]
+		bool operator==(const InUseIndexIterator& other) const noexcept
+		{
+			return m_wordIndex == other.m_wordIndex && m_inUseBits == other.m_inUseBits;
+		}
+
+	private:
+		void SkipEmptyWords() noexcept
+		{
+			const size_t wordCount = m_indicesManager->GetWordCount();
+
+			while (!m_inUseBits && m_wordIndex < wordCount)
+			{
+				++m_wordIndex;
+
+				if (m_wordIndex < wordCount)
+					m_inUseBits = m_indicesManager->GetInUseWord(m_wordIndex);
+			}
+		}
+
+	private:
+		const BasicIndicesManager* m_indicesManager;
+		size_t                     m_wordIndex;
+		std::uint64_t              m_inUseBits;
+	};
+
 public:
-	IndicesManager() : m_availableIndices{} {}
-	IndicesManager(size_t initialSize) : m_availableIndices(initialSize, true) {}
+	BasicIndicesManager()
+		: m_availableWords{}, m_summaryWords{}, m_indexCount{ 0u }, m_freeIndexCount{ 0u }
+	{}
+	BasicIndicesManager(size_t initialSize) : BasicIndicesManager{}
+	{
+		Resize(initialSize);
+	}
+	explicit BasicIndicesManager(const allocator_type& allocator)
+		: m_availableWords{ allocator }, m_summaryWords{ allocator }, m_indexCount{ 0u },
+		m_freeIndexCount{ 0u }
+	{}
+	BasicIndicesManager(size_t initialSize, const allocator_type& allocator)
+		: BasicIndicesManager{ allocator }
+	{
+		Resize(initialSize);
+	}
 
 	void ToggleAvailability(size_t index, bool on) noexcept
 	{
-		m_availableIndices[index] = on;
+		const size_t wordIndex  = index / s_bitsPerWord;
+		const std::uint64_t bit = std::uint64_t{ 1u } << (index % s_bitsPerWord);
+		std::uint64_t& word     = m_availableWords[wordIndex];
+
+		const bool wasAvailable = word & bit;
+
+		// The free count should only be changed if the availability was actually changed.
+		if (wasAvailable == on)
+			return;
+
+		if (on)
+		{
+			word |= bit;
+			++m_freeIndexCount;
+		}
+		else
+		{
+			word &= ~bit;
+			--m_freeIndexCount;
+		}
+
+		UpdateSummary(wordIndex);
+	}
+
+	// Sets the availability of count indices starting from the first index, a word at a time.
+	void ToggleAvailability(size_t firstIndex, size_t count, bool on) noexcept
+	{
+		size_t index          = firstIndex;
+		const size_t endIndex = firstIndex + count;
+
+		while (index < endIndex)
+		{
+			const size_t wordIndex = index / s_bitsPerWord;
+			const size_t bitIndex  = index % s_bitsPerWord;
+			const size_t bitCount  = std::min(s_bitsPerWord - bitIndex, endIndex - index);
+
+			const std::uint64_t mask = bitCount == s_bitsPerWord ?
+				~std::uint64_t{ 0u } : ((std::uint64_t{ 1u } << bitCount) - 1u) << bitIndex;
+
+			std::uint64_t& word = m_availableWords[wordIndex];
+
+			if (on)
+			{
+				m_freeIndexCount += std::popcount(~word & mask);
+				word             |= mask;
+			}
+			else
+			{
+				m_freeIndexCount -= std::popcount(word & mask);
+				word             &= ~mask;
+			}
+
+			UpdateSummary(wordIndex);
+
+			index += bitCount;
+		}
+	}
+
+	[[nodiscard]]
+	// Finds count consecutive available indices and marks them as in use. Returns the first
+	// index of the range or an empty optional if there isn't a large enough range.
+	std::optional<size_t> AllocateRange(
+		size_t count, FitPolicy policy = FitPolicy::FirstFit
+	) noexcept {
+		std::optional<size_t> firstIndex = FindAvailableRange(count, policy);
+
+		if (firstIndex)
+			ToggleAvailability(*firstIndex, count, false);
+
+		return firstIndex;
+	}
+
+	void FreeRange(size_t firstIndex, size_t count) noexcept
+	{
+		ToggleAvailability(firstIndex, count, true);
+	}
+
+	// Makes the indices available by setting the bits of the consecutive indices in the same
+	// word at once. So, the indices should be sorted to group as many of them as possible.
+	void FreeIndices(std::span<const std::uint32_t> indices) noexcept
+	{
+		if (std::empty(indices))
+			return;
+
+		size_t freedCount       = 0u;
+		size_t currentWordIndex = indices.front() / s_bitsPerWord;
+		std::uint64_t freeMask  = 0u;
+
+		auto ApplyMask = [this, &freedCount](size_t wordIndex, std::uint64_t mask) noexcept
+		{
+			std::uint64_t& word = m_availableWords[wordIndex];
+
+			freedCount += static_cast<size_t>(std::popcount(~word & mask));
+			word       |= mask;
+
+			UpdateSummary(wordIndex);
+		};
+
+		for (std::uint32_t index : indices)
+		{
+			const size_t wordIndex = index / s_bitsPerWord;
+
+			if (wordIndex != currentWordIndex)
+			{
+				ApplyMask(currentWordIndex, freeMask);
+
+				currentWordIndex = wordIndex;
+				freeMask         = 0u;
+			}
+
+			freeMask |= std::uint64_t{ 1u } << (index % s_bitsPerWord);
+		}
+
+		ApplyMask(currentWordIndex, freeMask);
+
+		m_freeIndexCount += freedCount;
+	}
+
+	[[nodiscard]]
+	// The number of available indices after the last index in use.
+	size_t GetTrailingAvailableCount() const noexcept
+	{
+		size_t availableCount = 0u;
+
+		for (size_t wordIndex = std::size(m_availableWords); wordIndex > 0u; --wordIndex)
+		{
+			// The bits after the last index are always unset, so they must be shifted out of the
+			// last word.
+			const size_t validBitCount = std::min(
+				m_indexCount - (wordIndex - 1u) * s_bitsPerWord, s_bitsPerWord
+			);
+			const std::uint64_t word   = m_availableWords[wordIndex - 1u]
+				<< (s_bitsPerWord - validBitCount);
+			const auto leadingOnes     = static_cast<size_t>(std::countl_one(word));
+
+			availableCount += leadingOnes;
+
+			if (leadingOnes < validBitCount)
+				break;
+		}
+
+		return availableCount;
+	}
+
+	void shrink_to_fit()
+	{
+		m_availableWords.shrink_to_fit();
+		m_summaryWords.shrink_to_fit();
 	}
 
 	void Resize(size_t newCount)
 	{
-		m_availableIndices.resize(newCount, true);
+		const size_t oldCount = m_indexCount;
+
+		// Unset the bits of the removed indices first, so the free count stays correct and the
+		// bits after the last index are unset.
+		if (newCount < oldCount)
+			ToggleAvailability(newCount, oldCount - newCount, false);
+
+		const size_t newWordCount = GetWordCount(newCount);
+
+		m_availableWords.resize(newWordCount, 0u);
+		m_summaryWords.resize(GetWordCount(newWordCount), 0u);
+
+		m_indexCount = newCount;
+
+		if (newCount > oldCount)
+			ToggleAvailability(oldCount, newCount - oldCount, true);
 	}
 
 	[[nodiscard]]
-	bool IsInUse(size_t index) const noexcept { return !m_availableIndices[index]; }
+	bool IsInUse(size_t index) const noexcept
+	{
+		const std::uint64_t bit = std::uint64_t{ 1u } << (index % s_bitsPerWord);
+
+		return !(m_availableWords[index / s_bitsPerWord] & bit);
+	}
 
 	[[nodiscard]]
 	std::optional<size_t> GetFirstAvailableIndex() const noexcept
 	{
-		auto result = std::ranges::find(m_availableIndices, true);
+		std::optional<size_t> wordIndex = FindAvailableWord(0u);
 
-		if (result != std::end(m_availableIndices))
-			return static_cast<size_t>(std::distance(std::begin(m_availableIndices), result));
+		if (wordIndex)
+			return *wordIndex * s_bitsPerWord + std::countr_zero(m_availableWords[*wordIndex]);
 		else
 			return {};
 	}
@@ -40,72 +331,504 @@ public:
 	[[nodiscard]]
 	std::optional<size_t> GetNextAvailableIndex(size_t currentIndex) const noexcept
 	{
-		const size_t indexCount = std::size(m_availableIndices);
+		const size_t startingIndex = currentIndex + 1u;
 
-		for (size_t index = currentIndex + 1u; index < indexCount; ++index)
-			if (m_availableIndices[index])
-				return index;
+		if (startingIndex >= m_indexCount)
+			return {};
 
-		return {};
+		// Check the rest of the current word first, and then search the words after it.
+		const size_t currentWordIndex = startingIndex / s_bitsPerWord;
+		const std::uint64_t restBits  = m_availableWords[currentWordIndex]
+			& (~std::uint64_t{ 0u } << (startingIndex % s_bitsPerWord));
+
+		if (restBits)
+			return currentWordIndex * s_bitsPerWord + std::countr_zero(restBits);
+
+		std::optional<size_t> wordIndex = FindAvailableWord(currentWordIndex + 1u);
+
+		if (wordIndex)
+			return *wordIndex * s_bitsPerWord + std::countr_zero(m_availableWords[*wordIndex]);
+		else
+			return {};
 	}
 
 	// Only doing it for U32 since I don't like unnecessary allocations and if we decide to
 	// store the indices, it will be as U32.
 	[[nodiscard]]
-	std::vector<std::uint32_t> GetAllAvailableIndicesU32() const noexcept
+	IndexVector_t GetAllAvailableIndicesU32() const noexcept
 	{
-		std::vector<std::uint32_t> availableIndices{};
+		IndexVector_t availableIndices{ GetIndexAllocator() };
 
-		const size_t indexCount = std::size(m_availableIndices);
+		availableIndices.reserve(m_freeIndexCount);
 
-		for (size_t index = 0u; index < indexCount; ++index)
-			if (m_availableIndices[index])
-				availableIndices.emplace_back(static_cast<std::uint32_t>(index));
+		GetAvailableIndicesU32(m_freeIndexCount, std::back_inserter(availableIndices));
 
 		return availableIndices;
 	}
 
+	// Writes up to maxCount available indices to the output iterator, without allocating.
+	// Returns the iterator after the last written index.
+	template<std::output_iterator<std::uint32_t> OutputIt>
+	OutputIt GetAvailableIndicesU32(size_t maxCount, OutputIt outputIt) const
+	{
+		const size_t wordCount = std::size(m_availableWords);
+
+		for (size_t wordIndex = 0u; wordIndex < wordCount && maxCount; ++wordIndex)
+		{
+			// Remove the lowest set bit after adding it, until every bit has been added.
+			for (std::uint64_t word = m_availableWords[wordIndex]; word && maxCount; word &= word - 1u)
+			{
+				*outputIt = static_cast<std::uint32_t>(
+					wordIndex * s_bitsPerWord + std::countr_zero(word)
+				);
+
+				++outputIt;
+				--maxCount;
+			}
+		}
+
+		return outputIt;
+	}
+
+	[[nodiscard]]
+	size_t GetFreeIndexCount() const noexcept { return m_freeIndexCount; }
+
+	[[nodiscard]]
+	size_t GetActiveIndexCount() const noexcept { return m_indexCount - m_freeIndexCount; }
+
+	void erase(size_t index)
+	{
+		erase(index, 1u);
+	}
+
+	// Removes count indices starting from the first index, and the indices after them are
+	// moved down by count.
+	void erase(size_t firstIndex, size_t count)
+	{
+		if (!count)
+			return;
+
+		// Unset the bits of the removed indices first, so the free count stays correct.
+		ToggleAvailability(firstIndex, count, false);
+
+		// Move the bits after the removed indices down a word at a time. The bits below the first
+		// index in its word should stay where they are.
+		const size_t newIndexCount  = m_indexCount - count;
+		const size_t firstWordIndex = firstIndex / s_bitsPerWord;
+
+		for (size_t index = firstIndex; index < newIndexCount;)
+		{
+			const size_t bitIndex       = index % s_bitsPerWord;
+			const std::uint64_t lowMask = (std::uint64_t{ 1u } << bitIndex) - 1u;
+			std::uint64_t& word         = m_availableWords[index / s_bitsPerWord];
+
+			word   = (word & lowMask) | (ReadWord(index + count) << bitIndex);
+			index += s_bitsPerWord - bitIndex;
+		}
+
+		m_indexCount = newIndexCount;
+
+		const size_t oldWordCount = std::size(m_availableWords);
+		const size_t newWordCount = GetWordCount(m_indexCount);
+
+		// The bits moved from after the last index were unset, so the bits after the new last
+		// index are unset too. But the removed words must be unset before updating the summary,
+		// as a summary word might be kept.
+		for (size_t wordIndex = newWordCount; wordIndex < oldWordCount; ++wordIndex)
+			m_availableWords[wordIndex] = 0u;
+
+		for (size_t wordIndex = firstWordIndex; wordIndex < oldWordCount; ++wordIndex)
+			UpdateSummary(wordIndex);
+
+		m_availableWords.resize(newWordCount);
+		m_summaryWords.resize(GetWordCount(newWordCount));
+	}
+
+	// Calls the function with every in use index.
+	template<typename Function>
+	void ForEachInUseIndex(Function&& function) const
+	{
+		ForEachInUseIndex(0u, GetWordCount(), std::forward<Function>(function));
+	}
+
+	// Calls the function with every in use index of the words in the range.
+	template<typename Function>
+	void ForEachInUseIndex(size_t firstWordIndex, size_t endWordIndex, Function&& function) const
+	{
+		for (size_t wordIndex = firstWordIndex; wordIndex < endWordIndex; ++wordIndex)
+			for (std::uint64_t word = GetInUseWord(wordIndex); word; word &= word - 1u)
+				function(wordIndex * s_bitsPerWord + std::countr_zero(word));
+	}
+
 	[[nodiscard]]
-	size_t GetFreeIndexCount() const noexcept
+	// Splits the words into at most chunkCount ranges, which have about the same number of in
+	// use indices, so they can be processed on different threads. The words without any in
+	// use index at the end aren't included.
+	std::vector<WordRange, Rebind_t<WordRange>> SplitInUseWords(size_t chunkCount) const
+	{
+		std::vector<WordRange, Rebind_t<WordRange>> wordRanges{
+			Rebind_t<WordRange>{ get_allocator() }
+		};
+
+		const size_t activeCount = GetActiveIndexCount();
+
+		if (!activeCount || !chunkCount)
+			return wordRanges;
+
+		const size_t indicesPerChunk = (activeCount + chunkCount - 1u) / chunkCount;
+		const size_t wordCount       = GetWordCount();
+
+		wordRanges.reserve(std::min(chunkCount, wordCount));
+
+		size_t firstWordIndex  = 0u;
+		size_t chunkIndexCount = 0u;
+
+		for (size_t wordIndex = 0u; wordIndex < wordCount; ++wordIndex)
+		{
+			chunkIndexCount += static_cast<size_t>(std::popcount(GetInUseWord(wordIndex)));
+
+			if (chunkIndexCount >= indicesPerChunk)
+			{
+				wordRanges.emplace_back(
+					WordRange{ .firstWordIndex = firstWordIndex, .endWordIndex = wordIndex + 1u }
+				);
+
+				firstWordIndex  = wordIndex + 1u;
+				chunkIndexCount = 0u;
+			}
+		}
+
+		if (chunkIndexCount)
+			wordRanges.emplace_back(
+				WordRange{ .firstWordIndex = firstWordIndex, .endWordIndex = wordCount }
+			);
+
+		return wordRanges;
+	}
+
+	// Calls the function with the first index and the count of every range of consecutive in
+	// use indices.
+	template<typename Function>
+	void ForEachInUseRange(Function&& function) const
 	{
-		return std::ranges::count(m_availableIndices, true);
+		const size_t wordCount = GetWordCount();
+
+		size_t rangeStart      = 0u;
+		size_t rangeLength     = 0u;
+
+		for (size_t wordIndex = 0u; wordIndex < wordCount; ++wordIndex)
+		{
+			const std::uint64_t word = GetInUseWord(wordIndex);
+			size_t bitIndex          = 0u;
+
+			while (bitIndex < s_bitsPerWord)
+			{
+				const std::uint64_t shiftedWord = word >> bitIndex;
+
+				if (shiftedWord & 1u)
+				{
+					if (!rangeLength)
+						rangeStart = wordIndex * s_bitsPerWord + bitIndex;
+
+					const auto inUseCount = static_cast<size_t>(std::countr_one(shiftedWord));
+
+					rangeLength += inUseCount;
+					bitIndex    += inUseCount;
+				}
+				else
+				{
+					if (rangeLength)
+					{
+						function(rangeStart, rangeLength);
+
+						rangeLength = 0u;
+					}
+
+					if (!shiftedWord)
+						break;
+
+					bitIndex += static_cast<size_t>(std::countr_zero(shiftedWord));
+				}
+			}
+		}
+
+		if (rangeLength)
+			function(rangeStart, rangeLength);
 	}
 
 	[[nodiscard]]
-	size_t GetActiveIndexCount() const noexcept
+	InUseIndexIterator InUseBegin() const noexcept { return InUseIndexIterator{ this, 0u }; }
+	[[nodiscard]]
+	InUseIndexIterator InUseEnd() const noexcept
+	{
+		return InUseIndexIterator{ this, GetWordCount() };
+	}
+	[[nodiscard]]
+	// The in use indices can be iterated with a range for loop with this.
+	std::ranges::subrange<InUseIndexIterator> GetInUseIndices() const noexcept
 	{
-		return std::ranges::count(m_availableIndices, false);
+		return { InUseBegin(), InUseEnd() };
 	}
 
-	void erase(size_t index)
+	size_t size() const noexcept { return m_indexCount; }
+
+	[[nodiscard]]
+	// A set bit means the index is available. The bits after the last index are unset.
+	std::span<const std::uint64_t> GetAvailableWords() const noexcept { return m_availableWords; }
+
+	// Replaces the availability of every index with the words, which should be the bytes of
+	// the words from GetAvailableWords. The bytes don't need to be aligned.
+	void LoadAvailableWords(size_t indexCount, std::span<const std::byte> wordBytes)
 	{
-		m_availableIndices.erase(std::next(std::begin(m_availableIndices), index));
+		const size_t wordCount = GetWordCount(indexCount);
+
+		assert(
+			std::size(wordBytes) == wordCount * sizeof(std::uint64_t)
+			&& "The byte count doesn't match the index count."
+		);
+
+		m_availableWords.resize(wordCount);
+
+		if (wordCount)
+			std::memcpy(std::data(m_availableWords), std::data(wordBytes), std::size(wordBytes));
+
+		m_indexCount = indexCount;
+
+		// Just in case, the bits after the last index must be unset.
+		if (const size_t lastBitCount = indexCount % s_bitsPerWord; lastBitCount)
+			m_availableWords.back() &= (std::uint64_t{ 1u } << lastBitCount) - 1u;
+
+		m_summaryWords.assign(GetWordCount(wordCount), 0u);
+
+		m_freeIndexCount = 0u;
+
+		for (size_t wordIndex = 0u; wordIndex < wordCount; ++wordIndex)
+		{
+			m_freeIndexCount += static_cast<size_t>(std::popcount(m_availableWords[wordIndex]));
+
+			UpdateSummary(wordIndex);
+		}
 	}
 
-	std::vector<bool>::size_type size() const noexcept { return std::size(m_availableIndices); }
+	[[nodiscard]]
+	allocator_type get_allocator() const noexcept { return m_availableWords.get_allocator(); }
+
+	[[nodiscard]]
+	// The allocator for the vectors of indices.
+	IndexVector_t::allocator_type GetIndexAllocator() const noexcept
+	{
+		return typename IndexVector_t::allocator_type{ get_allocator() };
+	}
 
 private:
-	std::vector<bool> m_availableIndices;
+	[[nodiscard]]
+	size_t GetWordCount() const noexcept { return std::size(m_availableWords); }
+
+	[[nodiscard]]
+	// The bits after the last index are unset in the available words, so they must be unset in
+	// the in use word too.
+	std::uint64_t GetInUseWord(size_t wordIndex) const noexcept
+	{
+		const size_t firstIndex    = wordIndex * s_bitsPerWord;
+		const size_t validBitCount = std::min(m_indexCount - firstIndex, s_bitsPerWord);
+		const std::uint64_t mask   = validBitCount == s_bitsPerWord ?
+			~std::uint64_t{ 0u } : (std::uint64_t{ 1u } << validBitCount) - 1u;
+
+		return ~m_availableWords[wordIndex] & mask;
+	}
+
+	[[nodiscard]]
+	// The 64 availability bits starting from the index, which don't need to be in the same word.
+	std::uint64_t ReadWord(size_t index) const noexcept
+	{
+		const size_t wordIndex = index / s_bitsPerWord;
+		const size_t bitIndex  = index % s_bitsPerWord;
+		const size_t wordCount = std::size(m_availableWords);
+
+		if (wordIndex >= wordCount)
+			return 0u;
+
+		std::uint64_t word = m_availableWords[wordIndex] >> bitIndex;
+
+		if (bitIndex && wordIndex + 1u < wordCount)
+			word |= m_availableWords[wordIndex + 1u] << (s_bitsPerWord - bitIndex);
+
+		return word;
+	}
+
+	[[nodiscard]]
+	static constexpr size_t GetWordCount(size_t bitCount) noexcept
+	{
+		return (bitCount + s_bitsPerWord - 1u) / s_bitsPerWord;
+	}
+
+	void UpdateSummary(size_t wordIndex) noexcept
+	{
+		const std::uint64_t summaryBit = std::uint64_t{ 1u } << (wordIndex % s_bitsPerWord);
+		std::uint64_t& summaryWord     = m_summaryWords[wordIndex / s_bitsPerWord];
+
+		if (m_availableWords[wordIndex])
+			summaryWord |= summaryBit;
+		else
+			summaryWord &= ~summaryBit;
+	}
+
+	[[nodiscard]]
+	std::optional<size_t> FindAvailableRange(size_t count, FitPolicy policy) const noexcept
+	{
+		assert(count && "Can't find a range of 0 indices.");
+
+		size_t rangeStart      = 0u;
+		size_t rangeLength     = 0u;
+		size_t bestRangeStart  = 0u;
+		size_t bestRangeLength = std::numeric_limits<size_t>::max();
+
+		const size_t wordCount = std::size(m_availableWords);
+
+		// Returns true if the search should be stopped.
+		auto EndRange = [&]() noexcept -> bool
+		{
+			const bool rangeFits = rangeLength >= count;
+
+			if (rangeFits && rangeLength < bestRangeLength)
+			{
+				bestRangeStart  = rangeStart;
+				bestRangeLength = rangeLength;
+			}
+
+			rangeLength = 0u;
+
+			// Can't find a better fit than an exact one.
+			return rangeFits && (policy == FitPolicy::FirstFit || bestRangeLength == count);
+		};
+
+		for (size_t wordIndex = 0u; wordIndex < wordCount; ++wordIndex)
+		{
+			const std::uint64_t word = m_availableWords[wordIndex];
+
+			// Skip the whole words quickly.
+			if (word == ~std::uint64_t{ 0u })
+			{
+				if (!rangeLength)
+					rangeStart = wordIndex * s_bitsPerWord;
+
+				rangeLength += s_bitsPerWord;
+
+				continue;
+			}
+
+			size_t bitIndex = 0u;
+
+			// Go through the ranges of set and unset bits in the word.
+			while (bitIndex < s_bitsPerWord)
+			{
+				const std::uint64_t shiftedWord = word >> bitIndex;
+
+				if (shiftedWord & 1u)
+				{
+					if (!rangeLength)
+						rangeStart = wordIndex * s_bitsPerWord + bitIndex;
+
+					// The shifted in bits are unset, so this can't go past the word.
+					const auto availableCount = static_cast<size_t>(std::countr_one(shiftedWord));
+
+					rangeLength += availableCount;
+					bitIndex    += availableCount;
+				}
+				else
+				{
+					if (rangeLength && EndRange())
+						return bestRangeStart;
+
+					if (!shiftedWord)
+						break;
+
+					bitIndex += static_cast<size_t>(std::countr_zero(shiftedWord));
+				}
+			}
+		}
+
+		// The last range might have reached the last word.
+		if (rangeLength)
+			EndRange();
+
+		if (bestRangeLength != std::numeric_limits<size_t>::max())
+			return bestRangeStart;
+		else
+			return {};
+	}
+
+	// Returns the index of the first word starting from firstWordIndex which has any available
+	// index.
+	[[nodiscard]]
+	std::optional<size_t> FindAvailableWord(size_t firstWordIndex) const noexcept
+	{
+		const size_t summaryWordCount = std::size(m_summaryWords);
+
+		size_t summaryIndex           = firstWordIndex / s_bitsPerWord;
+
+		if (summaryIndex >= summaryWordCount)
+			return {};
+
+		// Ignore the words before the first word in the first summary word.
+		std::uint64_t summaryWord = m_summaryWords[summaryIndex]
+			& (~std::uint64_t{ 0u } << (firstWordIndex % s_bitsPerWord));
+
+		while (!summaryWord)
+		{
+			++summaryIndex;
+
+			if (summaryIndex >= summaryWordCount)
+				return {};
+
+			summaryWord = m_summaryWords[summaryIndex];
+		}
+
+		return summaryIndex * s_bitsPerWord + std::countr_zero(summaryWord);
+	}
+
+private:
+	WordVector_t m_availableWords;
+	WordVector_t m_summaryWords;
+	size_t       m_indexCount;
+	size_t       m_freeIndexCount;
 
 public:
-	IndicesManager(const IndicesManager& other) noexcept
-		: m_availableIndices{ other.m_availableIndices }
+	BasicIndicesManager(const BasicIndicesManager& other) noexcept
+		: m_availableWords{ other.m_availableWords }, m_summaryWords{ other.m_summaryWords },
+		m_indexCount{ other.m_indexCount }, m_freeIndexCount{ other.m_freeIndexCount }
 	{}
-	IndicesManager& operator=(const IndicesManager& other) noexcept
+	BasicIndicesManager& operator=(const BasicIndicesManager& other) noexcept
 	{
-		m_availableIndices = other.m_availableIndices;
+		m_availableWords = other.m_availableWords;
+		m_summaryWords   = other.m_summaryWords;
+		m_indexCount     = other.m_indexCount;
+		m_freeIndexCount = other.m_freeIndexCount;
 
 		return *this;
 	}
-	IndicesManager(IndicesManager&& other) noexcept
-		: m_availableIndices{ std::move(other.m_availableIndices) }
+	BasicIndicesManager(BasicIndicesManager&& other) noexcept
+		: m_availableWords{ std::move(other.m_availableWords) },
+		m_summaryWords{ std::move(other.m_summaryWords) },
+		m_indexCount{ std::exchange(other.m_indexCount, 0u) },
+		m_freeIndexCount{ std::exchange(other.m_freeIndexCount, 0u) }
 	{}
-	IndicesManager& operator=(IndicesManager&& other) noexcept
+	BasicIndicesManager& operator=(BasicIndicesManager&& other) noexcept
 	{
-		m_availableIndices = std::move(other.m_availableIndices);
+		m_availableWords = std::move(other.m_availableWords);
+		m_summaryWords   = std::move(other.m_summaryWords);
+		m_indexCount     = std::exchange(other.m_indexCount, 0u);
+		m_freeIndexCount = std::exchange(other.m_freeIndexCount, 0u);
 
 		return *this;
 	}
 };
+
+using IndicesManager = BasicIndicesManager<>;
+
+namespace pmr
+{
+using IndicesManager = BasicIndicesManager<std::pmr::polymorphic_allocator<std::uint64_t>>;
+}
 }
 #endif
@@ -0,0 +1,217 @@
+#ifndef CALLISTO_PAGED_VECTOR_HPP_
+#define CALLISTO_PAGED_VECTOR_HPP_
+#include <vector>
+#include <memory>
+#include <bit>
+#include <iterator>
+#include <compare>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+namespace Callisto
+{
+// A vector which stores its elements in pages of pageSize elements. The pages are never moved
+// or reallocated when growing, so the addresses of the elements stay the same. Unlike
+// std::deque, the page size can be chosen, and since it must be a 2s exponent, finding the
+// page of an index is only a shift and a mask.
+// Every element of a page is default constructed when the page is allocated.
+template<typename T, size_t pageSize = 1024u>
+class PagedVector
+{
+	static_assert(std::has_single_bit(pageSize), "The page size must be a 2s exponent.");
+
+	static constexpr size_t s_pageShift = static_cast<size_t>(std::countr_zero(pageSize));
+	static constexpr size_t s_pageMask  = pageSize - 1u;
+
+	template<bool isConst>
+	class Iterator
+	{
+		friend class PagedVector;
+
+		using Container_t = std::conditional_t<isConst, const PagedVector, PagedVector>;
+
+	public:
+		using iterator_concept  = std::random_access_iterator_tag;
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type        = T;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = std::conditional_t<isConst, const T*, T*>;
+		using reference         = std::conditional_t<isConst, const T&, T&>;
+
+		Iterator() : m_container{ nullptr }, m_index{ 0u } {}
+		Iterator(Container_t* container, size_t index)
+			: m_container{ container }, m_index{ index }
+		{}
+
+		// Iterators can be converted to const iterators.
+		operator Iterator<true>() const noexcept { return Iterator<true>{ m_container, m_index }; }
+
+		reference operator*() const noexcept { return (*m_container)[m_index]; }
+		pointer operator->() const noexcept { return &(*m_container)[m_index]; }
+		reference operator[](difference_type offset) const noexcept
+		{
+			return (*m_container)[m_index + offset];
+		}
+
+		Iterator& operator++() noexcept { ++m_index; return *this; }
+		Iterator operator++(int) noexcept { Iterator previous = *this; ++m_index; return previous; }
+		Iterator& operator--() noexcept { --m_index; return *this; }
+		Iterator operator--(int) noexcept { Iterator previous = *this; --m_index; return previous; }
+
+		Iterator& operator+=(difference_type offset) noexcept { m_index += offset; return *this; }
+		Iterator& operator-=(difference_type offset) noexcept { m_index -= offset; return *this; }
+
+		friend Iterator operator+(Iterator it, difference_type offset) noexcept
+		{
+			return it += offset;
+		}
+		friend Iterator operator+(difference_type offset, Iterator it) noexcept
+		{
+			return it += offset;
+		}
+		friend Iterator operator-(Iterator it, difference_type offset) noexcept
+		{
+			return it -= offset;
+		}
+		friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.m_index)
+				- static_cast<difference_type>(rhs.m_index);
+		}
+
+		bool operator==(const Iterator& other) const noexcept { return m_index == other.m_index; }
+		auto operator<=>(const Iterator& other) const noexcept { return m_index <=> other.m_index; }
+
+	private:
+		Container_t* m_container;
+		size_t       m_index;
+	};
+
+public:
+	using value_type      = T;
+	using size_type       = size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference       = T&;
+	using const_reference = const T&;
+	using iterator        = Iterator<false>;
+	using const_iterator  = Iterator<true>;
+
+public:
+	PagedVector() : m_pages{}, m_size{ 0u } {}
+	PagedVector(size_t count) : PagedVector{}
+	{
+		resize(count);
+	}
+
+	// To use this, T must have a default ctor.
+	void resize(size_t newSize)
+	{
+		// The removed elements are reset, so they would be default constructed if the vector
+		// grows again, like with std::vector.
+		for (size_t index = newSize; index < m_size; ++index)
+			(*this)[index] = T{};
+
+		const size_t requiredPageCount = (newSize + s_pageMask) >> s_pageShift;
+
+		for (size_t pageIndex = std::size(m_pages); pageIndex < requiredPageCount; ++pageIndex)
+			m_pages.emplace_back(std::make_unique<T[]>(pageSize));
+
+		m_size = newSize;
+	}
+
+	// Frees the pages which aren't used anymore.
+	void shrink_to_fit()
+	{
+		m_pages.resize((m_size + s_pageMask) >> s_pageShift);
+		m_pages.shrink_to_fit();
+	}
+
+	void clear() noexcept { resize(0u); }
+
+	iterator erase(const_iterator position)
+	{
+		return erase(position, position + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		const size_t firstIndex = first.m_index;
+		const size_t count      = last.m_index - firstIndex;
+
+		if (!count)
+			return iterator{ this, firstIndex };
+
+		// Like with std::deque, the following elements will be moved. But the pages won't be.
+		for (size_t index = firstIndex; index + count < m_size; ++index)
+			(*this)[index] = std::move((*this)[index + count]);
+
+		resize(m_size - count);
+
+		return iterator{ this, firstIndex };
+	}
+
+	T& operator[](size_t index) noexcept
+	{
+		return m_pages[index >> s_pageShift][index & s_pageMask];
+	}
+	const T& operator[](size_t index) const noexcept
+	{
+		return m_pages[index >> s_pageShift][index & s_pageMask];
+	}
+
+	iterator begin() noexcept { return iterator{ this, 0u }; }
+	const_iterator begin() const noexcept { return const_iterator{ this, 0u }; }
+
+	iterator end() noexcept { return iterator{ this, m_size }; }
+	const_iterator end() const noexcept { return const_iterator{ this, m_size }; }
+
+	size_type size() const noexcept { return m_size; }
+
+	bool empty() const noexcept { return !m_size; }
+
+	[[nodiscard]]
+	static constexpr size_t GetPageSize() noexcept { return pageSize; }
+
+private:
+	std::vector<std::unique_ptr<T[]>> m_pages;
+	size_t                            m_size;
+
+public:
+	PagedVector(const PagedVector& other) : PagedVector{}
+	{
+		*this = other;
+	}
+	PagedVector& operator=(const PagedVector& other)
+	{
+		if (this == &other)
+			return *this;
+
+		m_pages.clear();
+
+		for (const std::unique_ptr<T[]>& otherPage : other.m_pages)
+		{
+			auto page = std::make_unique<T[]>(pageSize);
+
+			std::copy(otherPage.get(), otherPage.get() + pageSize, page.get());
+
+			m_pages.emplace_back(std::move(page));
+		}
+
+		m_size = other.m_size;
+
+		return *this;
+	}
+	PagedVector(PagedVector&& other) noexcept
+		: m_pages{ std::move(other.m_pages) }, m_size{ std::exchange(other.m_size, 0u) }
+	{}
+	PagedVector& operator=(PagedVector&& other) noexcept
+	{
+		m_pages = std::move(other.m_pages);
+		m_size  = std::exchange(other.m_size, 0u);
+
+		return *this;
+	}
+};
+}
+#endif
@@ -0,0 +1,221 @@
+#ifndef CALLISTO_REUSABLE_SLOT_MAP_HPP_
+#define CALLISTO_REUSABLE_SLOT_MAP_HPP_
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <IndicesManager.hpp>
+#include <CallistoException.hpp>
+
+namespace Callisto
+{
+// Unlike the ReusableContainer, the live elements are kept packed in a dense array, so iterating
+// doesn't visit the removed elements. Since the elements are moved when one is removed, they
+// are accessed with handles instead of indices. A handle keeps the index of its slot in the
+// lower bits and the generation of the slot in the upper bits. The generation is increased when
+// a slot is removed, so a stale handle won't access the new element of its slot. When the
+// generation of a slot can't be increased anymore, the slot is retired instead of wrapping
+// around, so a stale handle can never be valid again.
+template<typename T>
+class ReusableSlotMap
+{
+public:
+	using Handle = std::uint32_t;
+
+	static constexpr std::uint32_t s_slotIndexBits  = 20u;
+	static constexpr std::uint32_t s_slotIndexMask  = (1u << s_slotIndexBits) - 1u;
+	// The last generation of a slot. After a slot has been removed this many times, it is
+	// retired for the lifetime of the map and its memory isn't reclaimed, as a stale handle
+	// could match it again otherwise. So, a map which keeps adding and removing in the same few
+	// slots uses up a new slot every 4096 removals, and throws once it runs out of slot
+	// indices. Such a map should be recreated periodically.
+	static constexpr std::uint32_t s_generationMask = (1u << (32u - s_slotIndexBits)) - 1u;
+
+private:
+	// Doesn't fit in a handle, so no handle will match it.
+	static constexpr std::uint32_t s_retiredGeneration = s_generationMask + 1u;
+
+public:
+	ReusableSlotMap()
+		: m_elements{}, m_denseToSlot{}, m_slotToDense{}, m_generations{}, m_indicesManager{}
+	{}
+
+	template<typename U>
+	// Returns the handle of the new element. Throws if there are no slots left which fit in a
+	// handle.
+	Handle Add(U&& element)
+	{
+		std::optional<size_t> oSlotIndex = m_indicesManager.GetFirstAvailableIndex();
+
+		size_t slotIndex = 0u;
+
+		if (oSlotIndex)
+			slotIndex = oSlotIndex.value();
+		else
+		{
+			slotIndex = std::size(m_slotToDense);
+
+			if (slotIndex > s_slotIndexMask)
+				throw Exception("SlotMapError", "The slot index doesn't fit in a handle.");
+
+			m_slotToDense.emplace_back(0u);
+			m_generations.emplace_back(0u);
+			m_indicesManager.Resize(slotIndex + 1u);
+		}
+
+		const auto denseIndex = static_cast<std::uint32_t>(std::size(m_elements));
+
+		m_elements.emplace_back(std::forward<U>(element));
+		m_denseToSlot.emplace_back(static_cast<std::uint32_t>(slotIndex));
+
+		m_slotToDense[slotIndex] = denseIndex;
+		m_indicesManager.ToggleAvailability(slotIndex, false);
+
+		return MakeHandle(slotIndex, m_generations[slotIndex]);
+	}
+
+	// Moves the last element to the removed element's place, so the elements stay packed.
+	void Remove(Handle handle) noexcept
+	{
+		if (!IsValid(handle))
+			return;
+
+		const size_t slotIndex      = GetSlotIndex(handle);
+		const size_t denseIndex     = m_slotToDense[slotIndex];
+		const size_t lastDenseIndex = std::size(m_elements) - 1u;
+
+		if (denseIndex != lastDenseIndex)
+		{
+			const std::uint32_t movedSlotIndex = m_denseToSlot[lastDenseIndex];
+
+			m_elements[denseIndex]        = std::move(m_elements[lastDenseIndex]);
+			m_denseToSlot[denseIndex]     = movedSlotIndex;
+			m_slotToDense[movedSlotIndex] = static_cast<std::uint32_t>(denseIndex);
+		}
+
+		m_elements.pop_back();
+		m_denseToSlot.pop_back();
+
+		// A retired slot stays unavailable, so it is never reused.
+		if (m_generations[slotIndex] == s_generationMask)
+			m_generations[slotIndex] = s_retiredGeneration;
+		else
+		{
+			++m_generations[slotIndex];
+			m_indicesManager.ToggleAvailability(slotIndex, true);
+		}
+	}
+
+	[[nodiscard]]
+	bool IsValid(Handle handle) const noexcept
+	{
+		const size_t slotIndex = GetSlotIndex(handle);
+
+		return slotIndex < std::size(m_slotToDense) && m_indicesManager.IsInUse(slotIndex)
+			&& m_generations[slotIndex] == GetGeneration(handle);
+	}
+
+	[[nodiscard]]
+	// Returns nullptr if the handle is stale.
+	T* Get(Handle handle) noexcept
+	{
+		return IsValid(handle) ? &m_elements[m_slotToDense[GetSlotIndex(handle)]] : nullptr;
+	}
+	[[nodiscard]]
+	T const* Get(Handle handle) const noexcept
+	{
+		return IsValid(handle) ? &m_elements[m_slotToDense[GetSlotIndex(handle)]] : nullptr;
+	}
+
+	// The handle must be valid.
+	T& operator[](Handle handle) noexcept
+	{
+		return m_elements[m_slotToDense[GetSlotIndex(handle)]];
+	}
+	const T& operator[](Handle handle) const noexcept
+	{
+		return m_elements[m_slotToDense[GetSlotIndex(handle)]];
+	}
+
+	[[nodiscard]]
+	// The handle of the element at the index of the dense array.
+	Handle GetHandle(size_t denseIndex) const noexcept
+	{
+		const size_t slotIndex = m_denseToSlot[denseIndex];
+
+		return MakeHandle(slotIndex, m_generations[slotIndex]);
+	}
+
+	// Only the live elements are iterated. Don't keep the iterators or pointers after adding or
+	// removing an element, as the elements might have been moved.
+	std::vector<T>::iterator begin() { return std::begin(m_elements); }
+	std::vector<T>::const_iterator begin() const { return std::begin(m_elements); }
+
+	std::vector<T>::iterator end() { return std::end(m_elements); }
+	std::vector<T>::const_iterator end() const { return std::end(m_elements); }
+
+	std::vector<T>::size_type size() const noexcept { return std::size(m_elements); }
+
+	T* data() { return std::data(m_elements); }
+	T const* data() const { return std::data(m_elements); }
+
+	bool empty() const { return std::empty(m_elements); }
+
+	[[nodiscard]]
+	static size_t GetSlotIndex(Handle handle) noexcept { return handle & s_slotIndexMask; }
+	[[nodiscard]]
+	static std::uint32_t GetGeneration(Handle handle) noexcept
+	{
+		return handle >> s_slotIndexBits;
+	}
+
+private:
+	[[nodiscard]]
+	static Handle MakeHandle(size_t slotIndex, std::uint32_t generation) noexcept
+	{
+		return static_cast<Handle>(slotIndex) | (generation << s_slotIndexBits);
+	}
+
+private:
+	std::vector<T>             m_elements;
+	std::vector<std::uint32_t> m_denseToSlot;
+	std::vector<std::uint32_t> m_slotToDense;
+	std::vector<std::uint32_t> m_generations;
+	// Keeps track of the free slots.
+	IndicesManager             m_indicesManager;
+
+public:
+	ReusableSlotMap(const ReusableSlotMap& other) noexcept
+		: m_elements{ other.m_elements }, m_denseToSlot{ other.m_denseToSlot },
+		m_slotToDense{ other.m_slotToDense }, m_generations{ other.m_generations },
+		m_indicesManager{ other.m_indicesManager }
+	{}
+	ReusableSlotMap& operator=(const ReusableSlotMap& other) noexcept
+	{
+		m_elements       = other.m_elements;
+		m_denseToSlot    = other.m_denseToSlot;
+		m_slotToDense    = other.m_slotToDense;
+		m_generations    = other.m_generations;
+		m_indicesManager = other.m_indicesManager;
+
+		return *this;
+	}
+	ReusableSlotMap(ReusableSlotMap&& other) noexcept
+		: m_elements{ std::move(other.m_elements) },
+		m_denseToSlot{ std::move(other.m_denseToSlot) },
+		m_slotToDense{ std::move(other.m_slotToDense) },
+		m_generations{ std::move(other.m_generations) },
+		m_indicesManager{ std::move(other.m_indicesManager) }
+	{}
+	ReusableSlotMap& operator=(ReusableSlotMap&& other) noexcept
+	{
+		m_elements       = std::move(other.m_elements);
+		m_denseToSlot    = std::move(other.m_denseToSlot);
+		m_slotToDense    = std::move(other.m_slotToDense);
+		m_generations    = std::move(other.m_generations);
+		m_indicesManager = std::move(other.m_indicesManager);
+
+		return *this;
+	}
+};
+}
+#endif
@@ -0,0 +1,170 @@
+#ifndef CALLISTO_REUSABLE_SOA_HPP_
+#define CALLISTO_REUSABLE_SOA_HPP_
+#include <vector>
+#include <tuple>
+#include <span>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <type_traits>
+#include <IndicesManager.hpp>
+
+namespace Callisto
+{
+// Keeps a vector for every type, where the elements with the same index are the components of
+// one entry. The columns share a single IndicesManager, so a free index is only searched once
+// per entry, and a loop can only go through the columns it needs.
+template<typename... Ts>
+class ReusableSoA
+{
+	static_assert(sizeof...(Ts) > 0u, "There must be at least one column.");
+	// vector<bool> packs its elements into bits, so a column of it couldn't be a span. A
+	// std::uint8_t column can be used instead.
+	static_assert(
+		!(std::is_same_v<Ts, bool> || ...), "A column can't be bool, use std::uint8_t instead."
+	);
+
+	template<size_t columnIndex>
+	using Column_t = std::tuple_element_t<columnIndex, std::tuple<Ts...>>;
+
+public:
+	ReusableSoA() : m_columns{}, m_indicesManager{} {}
+	ReusableSoA(size_t initialSize)
+		: m_columns{ std::vector<Ts>(initialSize)... }, m_indicesManager{ initialSize }
+	{}
+
+	void Resize(size_t newTotalCount) noexcept
+	{
+		std::apply(
+			[newTotalCount](std::vector<Ts>&... columns) { (columns.resize(newTotalCount), ...); },
+			m_columns
+		);
+		m_indicesManager.Resize(newTotalCount);
+	}
+
+	void Extend(size_t elementsToAdd) noexcept
+	{
+		Resize(size() + elementsToAdd);
+	}
+
+	[[nodiscard]]
+	size_t GetNextFreeIndex(size_t extraAllocCount = 0) noexcept
+	{
+		size_t elementIndex                 = std::numeric_limits<size_t>::max();
+		std::optional<size_t> oElementIndex = m_indicesManager.GetFirstAvailableIndex();
+
+		if (oElementIndex)
+			elementIndex = oElementIndex.value();
+		else
+		{
+			elementIndex = size();
+
+			Resize(elementIndex + 1u + extraAllocCount);
+		}
+
+		return elementIndex;
+	}
+
+	template<typename... Us>
+	requires (sizeof...(Us) == sizeof...(Ts))
+	// Takes a component for every column. To use this, every type must have a default ctor for
+	// the reserving.
+	size_t Add(Us&&... components)
+	{
+		const size_t elementIndex = GetNextFreeIndex();
+
+		std::apply(
+			[elementIndex, &components...](std::vector<Ts>&... columns)
+			{ ((columns[elementIndex] = std::forward<Us>(components)), ...); },
+			m_columns
+		);
+
+		m_indicesManager.ToggleAvailability(elementIndex, false);
+
+		return elementIndex;
+	}
+
+	// Resets the components of every column.
+	void RemoveElement(size_t index) noexcept
+	{
+		std::apply(
+			[index](std::vector<Ts>&... columns) { ((columns[index] = Ts{}), ...); }, m_columns
+		);
+
+		m_indicesManager.ToggleAvailability(index, true);
+	}
+
+	[[nodiscard]]
+	bool IsInUse(size_t index) const noexcept { return m_indicesManager.IsInUse(index); }
+
+	template<size_t columnIndex>
+	[[nodiscard]]
+	Column_t<columnIndex>& Get(size_t index) noexcept
+	{
+		return std::get<columnIndex>(m_columns)[index];
+	}
+	template<size_t columnIndex>
+	[[nodiscard]]
+	const Column_t<columnIndex>& Get(size_t index) const noexcept
+	{
+		return std::get<columnIndex>(m_columns)[index];
+	}
+
+	template<size_t columnIndex>
+	[[nodiscard]]
+	// The whole column, including the components of the removed entries, which should be
+	// skipped with the IndicesManager if necessary.
+	std::span<Column_t<columnIndex>> Column() noexcept
+	{
+		return std::get<columnIndex>(m_columns);
+	}
+	template<size_t columnIndex>
+	[[nodiscard]]
+	std::span<const Column_t<columnIndex>> Column() const noexcept
+	{
+		return std::get<columnIndex>(m_columns);
+	}
+
+	[[nodiscard]]
+	// The indices of the entries which are in use.
+	auto GetActiveIndices() const noexcept { return m_indicesManager.GetInUseIndices(); }
+
+	size_t size() const noexcept { return std::size(std::get<0>(m_columns)); }
+
+	bool empty() const noexcept { return std::empty(std::get<0>(m_columns)); }
+
+	[[nodiscard]]
+	static constexpr size_t GetColumnCount() noexcept { return sizeof...(Ts); }
+
+	[[nodiscard]]
+	const IndicesManager& GetIndicesManager() const noexcept { return m_indicesManager; }
+
+private:
+	std::tuple<std::vector<Ts>...> m_columns;
+	IndicesManager                 m_indicesManager;
+
+public:
+	ReusableSoA(const ReusableSoA& other) noexcept
+		: m_columns{ other.m_columns }, m_indicesManager{ other.m_indicesManager }
+	{}
+	ReusableSoA& operator=(const ReusableSoA& other) noexcept
+	{
+		m_columns        = other.m_columns;
+		m_indicesManager = other.m_indicesManager;
+
+		return *this;
+	}
+	ReusableSoA(ReusableSoA&& other) noexcept
+		: m_columns{ std::move(other.m_columns) },
+		m_indicesManager{ std::move(other.m_indicesManager) }
+	{}
+	ReusableSoA& operator=(ReusableSoA&& other) noexcept
+	{
+		m_columns        = std::move(other.m_columns);
+		m_indicesManager = std::move(other.m_indicesManager);
+
+		return *this;
+	}
+};
+}
+#endif
@@ -4,22 +4,121 @@
 #include <deque>
 #include <type_traits>
 #include <utility>
+#include <limits>
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <memory>
+#include <optional>
+#include <cstddef>
+#include <cstring>
+#include <version>
+#include <thread>
+#if __has_include(<execution>)
+#include <execution>
+#endif
 #include <IndicesManager.hpp>
+#include <PagedVector.hpp>
+#include <CallistoException.hpp>
 
 namespace Callisto
 {
+// The elements from begin to before end have been changed.
+struct DirtyRange
+{
+	size_t begin;
+	size_t end;
+};
+
+// The image of a ReusableContainer starts with this header. The offsets are from the start of
+// the image and aligned for the elements and the availability words, so a mapped image can be
+// read without copying if the image itself is aligned.
+struct ReusableContainerImageHeader
+{
+	static constexpr std::uint32_t s_magic   = 0x49524C43u; // CLRI
+	static constexpr std::uint32_t s_version = 1u;
+
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint64_t elementSize;
+	std::uint64_t elementCount;
+	std::uint64_t elementOffset;
+	std::uint64_t wordCount;
+	std::uint64_t wordOffset;
+};
+
+// When the free fraction of the slots goes over the threshold after a removal, the free slots at
+// the end are trimmed. But some of them are kept as headroom, as a fraction of the slots before
+// them, so the next additions don't have to grow the container again. The threshold should be
+// larger than what the headroom leaves free, otherwise it would trim on every removal.
+struct TrimPolicy
+{
+	float freeFractionThreshold = 0.5f;
+	float headroomFraction      = 0.25f;
+};
+
+// The allocator of the container or std::allocator, if the container doesn't have one.
+template<typename Container_t>
+struct ContainerAllocator
+{
+	using type = std::allocator<typename Container_t::value_type>;
+};
+template<typename Container_t>
+requires requires { typename Container_t::allocator_type; }
+struct ContainerAllocator<Container_t>
+{
+	using type = Container_t::allocator_type;
+};
+
+// The allocator of the container is rebound for the IndicesManager and the returned index
+// vectors. So, with a stateful allocator, everything would be allocated from the same place.
 template<typename T, typename Container_t>
 class ReusableContainer
 {
+	static constexpr size_t s_bitsPerWord = 64u;
+
+	// The elements can only be copied to an image with memcpy if they are contiguous.
+	static constexpr bool s_isSerializable = std::is_trivially_copyable_v<T>
+		&& std::ranges::contiguous_range<Container_t>;
+
+	using ImageHeader_t = ReusableContainerImageHeader;
+
+public:
+	using allocator_type   = ContainerAllocator<Container_t>::type;
+	using IndicesManager_t = BasicIndicesManager<allocator_type>;
+	using IndexVector_t    = IndicesManager_t::IndexVector_t;
+
+private:
+	using DirtyWords_t     = std::vector<std::uint64_t, typename IndicesManager_t::allocator_type>;
+
 public:
-	ReusableContainer() : m_elements{}, m_indicesManager{} {}
-	ReusableContainer(size_t initialSize) : m_elements(initialSize), m_indicesManager{ initialSize }
+	ReusableContainer()
+		: m_elements{}, m_indicesManager{}, m_dirtyWords{}, m_dirtyTrackingEnabled{ false },
+		m_trimPolicy{}
+	{}
+	ReusableContainer(size_t initialSize)
+		: m_elements(initialSize), m_indicesManager{ initialSize }, m_dirtyWords{},
+		m_dirtyTrackingEnabled{ false }, m_trimPolicy{}
+	{}
+	explicit ReusableContainer(const allocator_type& allocator)
+		: m_elements(allocator), m_indicesManager{ allocator }, m_dirtyWords{ allocator },
+		m_dirtyTrackingEnabled{ false }, m_trimPolicy{}
+	{}
+	ReusableContainer(size_t initialSize, const allocator_type& allocator)
+		: m_elements(initialSize, allocator), m_indicesManager{ initialSize, allocator },
+		m_dirtyWords{ allocator }, m_dirtyTrackingEnabled{ false }, m_trimPolicy{}
 	{}
 
 	void Resize(size_t newTotalCount) noexcept
 	{
 		m_elements.resize(newTotalCount);
 		m_indicesManager.Resize(newTotalCount);
+
+		if (m_dirtyTrackingEnabled)
+			m_dirtyWords.resize((newTotalCount + s_bitsPerWord - 1u) / s_bitsPerWord, 0u);
 	}
 
 	void Extend(size_t elementsToAdd) noexcept
@@ -29,7 +128,7 @@ public:
 
 	[[nodiscard]]
 	// If these many indices are free then return that or allocate that many.
-	std::vector<std::uint32_t> GetFreeIndicesU32(size_t requiredFreeIndexCount) noexcept
+	IndexVector_t GetFreeIndicesU32(size_t requiredFreeIndexCount) noexcept
 	{
 		const size_t freeIndexCount = m_indicesManager.GetFreeIndexCount();
 
@@ -39,42 +138,128 @@ public:
 		return m_indicesManager.GetAllAvailableIndicesU32();
 	}
 
+	// Writes requiredFreeIndexCount free indices to the output iterator and allocates the
+	// missing ones. The indices aren't marked as in use.
+	template<std::output_iterator<std::uint32_t> OutputIt>
+	OutputIt GetFreeIndicesU32(size_t requiredFreeIndexCount, OutputIt outputIt) noexcept
+	{
+		const size_t freeIndexCount = m_indicesManager.GetFreeIndexCount();
+
+		if (freeIndexCount < requiredFreeIndexCount)
+			Resize(size() + requiredFreeIndexCount - freeIndexCount);
+
+		return m_indicesManager.GetAvailableIndicesU32(requiredFreeIndexCount, outputIt);
+	}
+
 	[[nodiscard]]
 	// To use this, T must have a copy and a default ctor for the reserving.
-	std::vector<std::uint32_t> AddElementsU32(std::vector<T>&& elements)
+	IndexVector_t AddElementsU32(std::vector<T>&& elements)
 	{
-		std::vector<std::uint32_t> freeIndices = GetFreeIndicesU32(std::size(elements));
-
-		const size_t newElementCount           = std::size(freeIndices);
+		IndexVector_t freeIndices{ m_indicesManager.GetIndexAllocator() };
 
-		for (size_t index = 0u; index < newElementCount; ++index)
-		{
-			const size_t freeIndex = freeIndices[index];
+		freeIndices.reserve(std::size(elements));
 
-			m_elements[freeIndex]  = std::move(elements[index]);
-			m_indicesManager.ToggleAvailability(freeIndex, false);
-		}
+		AddElementsU32(std::move(elements), std::back_inserter(freeIndices));
 
 		return freeIndices;
 	}
 
 	[[nodiscard]]
 	// To use this, T must have a copy and a default ctor for the reserving.
-	std::vector<std::uint32_t> AddElementsU32(const std::vector<T>& elements)
+	IndexVector_t AddElementsU32(const std::vector<T>& elements)
+	{
+		IndexVector_t freeIndices{ m_indicesManager.GetIndexAllocator() };
+
+		freeIndices.reserve(std::size(elements));
+
+		AddElementsU32(elements, std::back_inserter(freeIndices));
+
+		return freeIndices;
+	}
+
+	// Adds the elements of any range and writes their indices to the output iterator, so the
+	// indices can be written to a span or an existing container without allocating. The elements
+	// will be moved if the range is an rvalue. Returns the iterator after the last written index.
+	// To use this, T must have a copy and a default ctor for the reserving.
+	template<std::ranges::input_range Range_t, std::output_iterator<std::uint32_t> OutputIt>
+	OutputIt AddElementsU32(Range_t&& elements, OutputIt outputIt)
 	{
-		std::vector<std::uint32_t> freeIndices = GetFreeIndicesU32(std::size(elements));
+		// If the count is known, allocate all of the missing indices at once.
+		if constexpr (std::ranges::sized_range<Range_t>)
+		{
+			const auto elementCount     = static_cast<size_t>(std::ranges::size(elements));
+			const size_t freeIndexCount = m_indicesManager.GetFreeIndexCount();
+
+			if (freeIndexCount < elementCount)
+				Resize(size() + elementCount - freeIndexCount);
+		}
 
-		const size_t newElementCount           = std::size(freeIndices);
+		// Walk the free indices only once, by searching for the next one after the last one.
+		std::optional<size_t> oFreeIndex = m_indicesManager.GetFirstAvailableIndex();
 
-		for (size_t index = 0u; index < newElementCount; ++index)
+		for (auto it = std::ranges::begin(elements); it != std::ranges::end(elements); ++it)
 		{
-			const size_t freeIndex = freeIndices[index];
+			if (!oFreeIndex)
+			{
+				oFreeIndex = size();
+
+				Extend(1u);
+			}
+
+			const size_t freeIndex = oFreeIndex.value();
+
+			// Only an owning rvalue range can be moved from. A view or a borrowed range, like a
+			// span, refers to the caller's elements, even if it is an rvalue.
+			if constexpr (
+				std::is_lvalue_reference_v<Range_t> || std::ranges::borrowed_range<Range_t>
+				|| std::ranges::view<std::remove_cvref_t<Range_t>>
+			)
+				m_elements[freeIndex] = *it;
+			else
+				m_elements[freeIndex] = std::ranges::iter_move(it);
 
-			m_elements[freeIndex]  = elements[index];
 			m_indicesManager.ToggleAvailability(freeIndex, false);
+			MarkDirty(freeIndex);
+
+			oFreeIndex = m_indicesManager.GetNextAvailableIndex(freeIndex);
+
+			*outputIt = static_cast<std::uint32_t>(freeIndex);
+			++outputIt;
 		}
 
-		return freeIndices;
+		return outputIt;
+	}
+
+	[[nodiscard]]
+	// Adds the elements to consecutive indices and returns the first index. To use this, T must
+	// have a copy and a default ctor for the reserving.
+	size_t AddRange(std::vector<T>&& elements, FitPolicy policy = FitPolicy::FirstFit)
+	{
+		const size_t elementCount = std::size(elements);
+		const size_t firstIndex   = GetFreeRange(elementCount, policy);
+
+		for (size_t index = 0u; index < elementCount; ++index)
+			m_elements[firstIndex + index] = std::move(elements[index]);
+
+		MarkDirty(firstIndex, elementCount);
+
+		return firstIndex;
+	}
+
+	[[nodiscard]]
+	// Adds the elements to consecutive indices and returns the first index. To use this, T must
+	// have a copy and a default ctor for the reserving.
+	size_t AddRange(const std::vector<T>& elements, FitPolicy policy = FitPolicy::FirstFit)
+	{
+		const size_t elementCount = std::size(elements);
+		const size_t firstIndex   = GetFreeRange(elementCount, policy);
+
+		for (size_t index = 0u; index < elementCount; ++index)
+			m_elements[firstIndex + index] = elements[index];
+
+		MarkDirty(firstIndex, elementCount);
+
+		return firstIndex;
 	}
 
 	[[nodiscard]]
@@ -108,6 +293,7 @@ public:
 
 		m_elements[elementIndex] = std::forward<U>(element);
 		m_indicesManager.ToggleAvailability(elementIndex, false);
+		MarkDirty(elementIndex);
 
 		return elementIndex;
 	}
@@ -116,6 +302,161 @@ public:
 	{
 		m_elements[index] = T{};
 		MakeUnavailable(index);
+		MarkDirty(index);
+
+		TrimIfRequired();
+	}
+
+	void RemoveRange(size_t firstIndex, size_t count) noexcept
+	{
+		for (size_t index = firstIndex; index < firstIndex + count; ++index)
+			m_elements[index] = T{};
+
+		m_indicesManager.FreeRange(firstIndex, count);
+		MarkDirty(firstIndex, count);
+
+		TrimIfRequired();
+	}
+
+	// Resets all of the elements first and then frees their indices, a word at a time. The
+	// indices should be sorted, so more of them would be in the same word.
+	void RemoveElements(std::span<const std::uint32_t> indices) noexcept
+	{
+		for (std::uint32_t index : indices)
+		{
+			m_elements[index] = T{};
+
+			MarkDirty(index);
+		}
+
+		m_indicesManager.FreeIndices(indices);
+
+		TrimIfRequired();
+	}
+
+	// The trailing free slots will be trimmed automatically after removing with the policy.
+	// An empty optional disables it.
+	void SetTrimPolicy(std::optional<TrimPolicy> trimPolicy) noexcept
+	{
+		m_trimPolicy = trimPolicy;
+	}
+
+	// Removes the free slots at the end, apart from the headroom. Returns the removed count.
+	size_t TrimTrailingFreeSlots(size_t headroom = 0u) noexcept
+	{
+		const size_t trailingFreeCount = m_indicesManager.GetTrailingAvailableCount();
+
+		if (trailingFreeCount <= headroom)
+			return 0u;
+
+		const size_t removedCount = trailingFreeCount - headroom;
+
+		Resize(size() - removedCount);
+
+		return removedCount;
+	}
+
+	// Frees the unused capacity, so it should be called after trimming.
+	void shrink_to_fit()
+	requires requires(Container_t& container) { container.shrink_to_fit(); }
+	{
+		m_elements.shrink_to_fit();
+		m_indicesManager.shrink_to_fit();
+		m_dirtyWords.shrink_to_fit();
+	}
+
+	[[nodiscard]]
+	// Marks the element as dirty before returning it, so it should be used instead of
+	// operator[] to write to an element if the dirty tracking is enabled.
+	T& Modify(size_t index) noexcept
+	{
+		MarkDirty(index);
+
+		return m_elements[index];
+	}
+
+	// With the dirty tracking, the indices of the changed elements are kept, so only those need
+	// to be copied to a GPU buffer. Every element is dirty after enabling it, as the previous
+	// changes weren't tracked.
+	void EnableDirtyTracking(bool enable) noexcept
+	{
+		m_dirtyTrackingEnabled = enable;
+
+		m_dirtyWords.clear();
+
+		if (enable)
+		{
+			m_dirtyWords.resize((size() + s_bitsPerWord - 1u) / s_bitsPerWord, 0u);
+
+			MarkDirty(0u, size());
+		}
+	}
+
+	[[nodiscard]]
+	bool IsDirtyTrackingEnabled() const noexcept { return m_dirtyTrackingEnabled; }
+
+	void MarkDirty(size_t index) noexcept
+	{
+		if (m_dirtyTrackingEnabled)
+			m_dirtyWords[index / s_bitsPerWord] |= std::uint64_t{ 1u } << (index % s_bitsPerWord);
+	}
+
+	void MarkDirty(size_t firstIndex, size_t count) noexcept
+	{
+		if (!m_dirtyTrackingEnabled)
+			return;
+
+		size_t index          = firstIndex;
+		const size_t endIndex = firstIndex + count;
+
+		while (index < endIndex)
+		{
+			const size_t bitIndex = index % s_bitsPerWord;
+			const size_t bitCount = std::min(s_bitsPerWord - bitIndex, endIndex - index);
+
+			m_dirtyWords[index / s_bitsPerWord] |= bitCount == s_bitsPerWord ?
+				~std::uint64_t{ 0u } : ((std::uint64_t{ 1u } << bitCount) - 1u) << bitIndex;
+
+			index += bitCount;
+		}
+	}
+
+	[[nodiscard]]
+	// Returns the ranges of consecutive dirty elements and marks every element as clean.
+	std::vector<DirtyRange> ConsumeDirtyRanges()
+	{
+		std::vector<DirtyRange> dirtyRanges{};
+
+		const size_t elementCount = size();
+		const size_t wordCount    = std::size(m_dirtyWords);
+
+		for (size_t wordIndex = 0u; wordIndex < wordCount; ++wordIndex)
+		{
+			std::uint64_t word = std::exchange(m_dirtyWords[wordIndex], 0u);
+
+			while (word)
+			{
+				const auto bitIndex = static_cast<size_t>(std::countr_zero(word));
+				const auto bitCount = static_cast<size_t>(std::countr_one(word >> bitIndex));
+				const size_t begin  = wordIndex * s_bitsPerWord + bitIndex;
+				const size_t end    = std::min(begin + bitCount, elementCount);
+
+				// The bits of the removed elements might still be set after shrinking.
+				if (begin >= end)
+					break;
+
+				// Join the range with the previous one if it continues from the last word.
+				if (!std::empty(dirtyRanges) && dirtyRanges.back().end == begin)
+					dirtyRanges.back().end = end;
+				else
+					dirtyRanges.emplace_back(DirtyRange{ .begin = begin, .end = end });
+
+				word = bitIndex + bitCount == s_bitsPerWord ?
+					0u : word & (~std::uint64_t{ 0u } << (bitIndex + bitCount));
+			}
+		}
+
+		return dirtyRanges;
 	}
 
 	void MakeUnavailable(size_t index) noexcept
@@ -126,6 +467,72 @@ public:
 	[[nodiscard]]
 	bool IsInUse(size_t index) const noexcept { return m_indicesManager.IsInUse(index); }
 
+	// Calls the function with only the elements which are in use. The function can either take
+	// the element or the index and the element.
+	template<typename Function>
+	void ForEachActive(Function&& function)
+	{
+		m_indicesManager.ForEachInUseIndex(
+			[this, &function](size_t index) { CallWithElement(function, index, m_elements[index]); }
+		);
+	}
+	template<typename Function>
+	void ForEachActive(Function&& function) const
+	{
+		m_indicesManager.ForEachInUseIndex(
+			[this, &function](size_t index) { CallWithElement(function, index, m_elements[index]); }
+		);
+	}
+
+#ifdef __cpp_lib_execution
+	// Splits the elements into chunks, which have about the same number of elements in use, and
+	// calls the function with the elements in use of every chunk with the execution policy. So,
+	// the function must be safe to call from multiple threads. The chunks are split by the 64
+	// bit availability words, so they start at multiples of 64 elements. They aren't sized to
+	// cache lines, but a chunk won't share a cache line with another one if the storage is 64
+	// byte aligned. If the chunk count is 0, it will be four times the hardware thread count.
+	// With libstdc++, the parallel policies need TBB, so link CallistoParallel to use them.
+	template<typename ExecutionPolicy, typename Function>
+	requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	void ParallelForEachActive(
+		ExecutionPolicy&& policy, Function&& function, size_t chunkCount = 0u
+	) {
+		ParallelForEachActiveImpl(std::forward<ExecutionPolicy>(policy), *this, function, chunkCount);
+	}
+	template<typename ExecutionPolicy, typename Function>
+	requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	void ParallelForEachActive(
+		ExecutionPolicy&& policy, Function&& function, size_t chunkCount = 0u
+	) const {
+		ParallelForEachActiveImpl(std::forward<ExecutionPolicy>(policy), *this, function, chunkCount);
+	}
+#endif
+
+	// Calls the function with the first index and a span of every range of consecutive elements
+	// which are in use.
+	template<typename Function>
+	requires std::ranges::contiguous_range<Container_t>
+	void ForEachActiveChunk(Function&& function)
+	{
+		m_indicesManager.ForEachInUseRange(
+			[this, &function](size_t firstIndex, size_t count)
+			{ function(firstIndex, std::span<T>{ std::data(m_elements) + firstIndex, count }); }
+		);
+	}
+	template<typename Function>
+	requires std::ranges::contiguous_range<Container_t>
+	void ForEachActiveChunk(Function&& function) const
+	{
+		m_indicesManager.ForEachInUseRange(
+			[this, &function](size_t firstIndex, size_t count)
+			{ function(firstIndex, std::span<const T>{ std::data(m_elements) + firstIndex, count }); }
+		);
+	}
+
+	[[nodiscard]]
+	// The indices of the elements which are in use.
+	auto GetActiveIndices() const noexcept { return m_indicesManager.GetInUseIndices(); }
+
 	T& at(size_t index) noexcept { return m_elements[index]; }
 	const T& at(size_t index) const noexcept { return m_elements[index]; }
 
@@ -151,26 +558,177 @@ public:
 	{
 		m_elements.erase(std::next(std::begin(m_elements), index));
 		m_indicesManager.erase(index);
+
+		// Every element after the index has been moved.
+		MarkDirty(index, size() - index);
+	}
+
+	void erase(size_t firstIndex, size_t count)
+	{
+		const auto first = std::next(std::begin(m_elements), firstIndex);
+
+		m_elements.erase(first, std::next(first, count));
+		m_indicesManager.erase(firstIndex, count);
+
+		MarkDirty(firstIndex, size() - firstIndex);
 	}
 
 	void EraseInactiveElements() noexcept
 	{
-		size_t inactiveElementCount = m_indicesManager.GetFreeIndexCount();
+		Compact([](size_t, size_t) {});
+	}
 
-		// Removing in reverse should be more efficient.
-		size_t currentIndex         = std::size(m_elements) - 1u;
+	// Moves the elements in use to the front in a single pass while keeping their order, and
+	// removes the rest. The function will be called with the old and the new index of every
+	// moved element, so the stored indices can be updated.
+	template<typename Function>
+	void Compact(Function&& remapFunction)
+	{
+		size_t newIndex = 0u;
 
-		while (inactiveElementCount)
-		{
-			if (!m_indicesManager.IsInUse(currentIndex))
+		m_indicesManager.ForEachInUseIndex(
+			[this, &remapFunction, &newIndex](size_t oldIndex)
 			{
-				--inactiveElementCount;
+				if (oldIndex != newIndex)
+				{
+					m_elements[newIndex] = std::move(m_elements[oldIndex]);
 
-				erase(currentIndex);
+					MarkDirty(newIndex);
+
+					remapFunction(oldIndex, newIndex);
+				}
+
+				++newIndex;
 			}
-			else
-				--currentIndex;
-		}
+		);
+
+		Resize(newIndex);
+
+		m_indicesManager.ToggleAvailability(0u, newIndex, false);
+	}
+
+	[[nodiscard]]
+	// Returns a table with the new index of every old index. The removed elements will have
+	// std::numeric_limits<std::uint32_t>::max() as their new index.
+	IndexVector_t Compact()
+	{
+		IndexVector_t remapTable(
+			size(), std::numeric_limits<std::uint32_t>::max(), m_indicesManager.GetIndexAllocator()
+		);
+
+		m_indicesManager.ForEachInUseIndex(
+			[&remapTable](size_t index) { remapTable[index] = static_cast<std::uint32_t>(index); }
+		);
+
+		Compact(
+			[&remapTable](size_t oldIndex, size_t newIndex)
+			{ remapTable[oldIndex] = static_cast<std::uint32_t>(newIndex); }
+		);
+
+		return remapTable;
+	}
+
+	[[nodiscard]]
+	size_t GetSerializedSize() const noexcept requires s_isSerializable
+	{
+		return GetImageSize(MakeImageHeader(size()));
+	}
+
+	// Writes the header, the elements and the availability words to the image, which must be
+	// at least GetSerializedSize bytes. The elements are copied with memcpy, so if T has any
+	// padding, its bytes are copied as they are, and two equal containers might not have the
+	// same image.
+	void Serialize(std::span<std::byte> image) const requires s_isSerializable
+	{
+		const ImageHeader_t header = MakeImageHeader(size());
+		const size_t elementSize   = header.elementCount * sizeof(T);
+
+		if (std::size(image) < GetImageSize(header))
+			throw Exception("SerializationError", "The image is smaller than the serialized size.");
+
+		std::byte* imageStart = std::data(image);
+
+		std::memcpy(imageStart, &header, sizeof(header));
+
+		// Zero the padding between the parts, so it doesn't leak whatever was in the image.
+		std::memset(imageStart + sizeof(header), 0, header.elementOffset - sizeof(header));
+		std::memset(
+			imageStart + header.elementOffset + elementSize, 0,
+			header.wordOffset - header.elementOffset - elementSize
+		);
+
+		if (elementSize)
+			std::memcpy(imageStart + header.elementOffset, std::data(m_elements), elementSize);
+
+		std::span<const std::uint64_t> availableWords = m_indicesManager.GetAvailableWords();
+
+		if (!std::empty(availableWords))
+			std::memcpy(
+				imageStart + header.wordOffset, std::data(availableWords),
+				std::size(availableWords) * sizeof(std::uint64_t)
+			);
+	}
+
+	[[nodiscard]]
+	std::vector<std::byte> Serialize() const requires s_isSerializable
+	{
+		std::vector<std::byte> image(GetSerializedSize());
+
+		Serialize(image);
+
+		return image;
+	}
+
+	// Replaces the elements and their availability with the ones in the image. The image
+	// doesn't need to be aligned.
+	void Deserialize(std::span<const std::byte> image) requires s_isSerializable
+	{
+		if (std::size(image) < sizeof(ImageHeader_t))
+			throw Exception("DeserializationError", "The image is smaller than its header.");
+
+		ImageHeader_t header{};
+
+		std::memcpy(&header, std::data(image), sizeof(header));
+
+		if (header.magic != ImageHeader_t::s_magic || header.version != ImageHeader_t::s_version)
+			throw Exception("DeserializationError", "The image isn't of a supported version.");
+
+		if (header.elementSize != sizeof(T))
+			throw Exception("DeserializationError", "The element size of the image doesn't match.");
+
+		// The element count isn't trusted yet, so it must be checked against the size of the
+		// image before it is used for any size calculation, which could overflow otherwise.
+		const size_t imageSize     = std::size(image);
+		const size_t elementOffset = MakeImageHeader(0u).elementOffset;
+
+		if (header.elementOffset != elementOffset || imageSize < elementOffset
+			|| header.elementCount > (imageSize - elementOffset) / sizeof(T))
+			throw Exception("DeserializationError", "The element count of the image is invalid.");
+
+		const ImageHeader_t expectedHeader = MakeImageHeader(header.elementCount);
+
+		if (header.elementOffset != expectedHeader.elementOffset
+			|| header.wordCount != expectedHeader.wordCount
+			|| header.wordOffset != expectedHeader.wordOffset
+			|| std::size(image) < GetImageSize(expectedHeader))
+			throw Exception("DeserializationError", "The layout of the image is invalid.");
+
+		const auto elementCount = static_cast<size_t>(header.elementCount);
+
+		Resize(elementCount);
+
+		if (elementCount)
+			std::memcpy(
+				std::data(m_elements), std::data(image) + header.elementOffset,
+				elementCount * sizeof(T)
+			);
+
+		m_indicesManager.LoadAvailableWords(
+			elementCount,
+			image.subspan(header.wordOffset, header.wordCount * sizeof(std::uint64_t))
+		);
+
+		MarkDirty(0u, elementCount);
 	}
 
 	[[nodiscard]]
@@ -185,31 +743,164 @@ public:
 	size_t GetCount() const noexcept { return std::size(m_elements); }
 
 	[[nodiscard]]
-	const IndicesManager& GetIndicesManager() const noexcept { return m_indicesManager; }
+	const IndicesManager_t& GetIndicesManager() const noexcept { return m_indicesManager; }
+
+	[[nodiscard]]
+	allocator_type get_allocator() const noexcept { return m_indicesManager.get_allocator(); }
 
 private:
-	Container_t    m_elements;
-	IndicesManager m_indicesManager;
+#ifdef __cpp_lib_execution
+	// The implementation for both the const and non-const containers.
+	template<typename ExecutionPolicy, typename Self_t, typename Function>
+	static void ParallelForEachActiveImpl(
+		ExecutionPolicy&& policy, Self_t& self, Function& function, size_t chunkCount
+	) {
+		if (!chunkCount)
+			chunkCount = std::max(std::thread::hardware_concurrency(), 1u) * 4u;
+
+		const auto wordRanges = self.m_indicesManager.SplitInUseWords(chunkCount);
+
+		using WordRange_t     = IndicesManager_t::WordRange;
+
+		std::for_each(
+			std::forward<ExecutionPolicy>(policy), std::begin(wordRanges), std::end(wordRanges),
+			[&self, &function](const WordRange_t& wordRange)
+			{
+				self.m_indicesManager.ForEachInUseIndex(
+					wordRange.firstWordIndex, wordRange.endWordIndex,
+					[&self, &function](size_t index)
+					{ CallWithElement(function, index, self.m_elements[index]); }
+				);
+			}
+		);
+	}
+#endif
+
+	[[nodiscard]]
+	static constexpr size_t AlignUp(size_t offset, size_t alignment) noexcept
+	{
+		return (offset + alignment - 1u) / alignment * alignment;
+	}
+
+	[[nodiscard]]
+	static constexpr ImageHeader_t MakeImageHeader(size_t elementCount) noexcept
+	{
+		const size_t elementOffset = AlignUp(
+			sizeof(ImageHeader_t), std::max(alignof(T), alignof(std::uint64_t))
+		);
+
+		return ImageHeader_t{
+			.magic         = ImageHeader_t::s_magic,
+			.version       = ImageHeader_t::s_version,
+			.elementSize   = sizeof(T),
+			.elementCount  = elementCount,
+			.elementOffset = elementOffset,
+			.wordCount     = (elementCount + s_bitsPerWord - 1u) / s_bitsPerWord,
+			.wordOffset    = AlignUp(
+				elementOffset + elementCount * sizeof(T), alignof(std::uint64_t)
+			)
+		};
+	}
+
+	[[nodiscard]]
+	static constexpr size_t GetImageSize(const ImageHeader_t& header) noexcept
+	{
+		return header.wordOffset + header.wordCount * sizeof(std::uint64_t);
+	}
+
+	void TrimIfRequired() noexcept
+	{
+		if (!m_trimPolicy)
+			return;
+
+		const TrimPolicy& trimPolicy = m_trimPolicy.value();
+		const auto elementCount      = static_cast<float>(size());
+		const auto freeCount         = static_cast<float>(m_indicesManager.GetFreeIndexCount());
+
+		if (freeCount <= elementCount * trimPolicy.freeFractionThreshold)
+			return;
+
+		// The headroom is based on the slots before the trailing free ones, so it shrinks with
+		// the live slots.
+		const size_t usedEnd = size() - m_indicesManager.GetTrailingAvailableCount();
+		const auto headroom  = static_cast<size_t>(
+			static_cast<float>(usedEnd) * trimPolicy.headroomFraction
+		);
+
+		TrimTrailingFreeSlots(headroom);
+	}
+
+	template<typename Function, typename Element_t>
+	static void CallWithElement(Function& function, size_t index, Element_t& element)
+	{
+		if constexpr (std::invocable<Function&, size_t, Element_t&>)
+			function(index, element);
+		else
+			function(element);
+	}
+
+	[[nodiscard]]
+	// Returns the first index of count consecutive indices, which have been marked as in use.
+	size_t GetFreeRange(size_t count, FitPolicy policy) noexcept
+	{
+		// An empty range doesn't need any index, and the trailing free indices shouldn't be
+		// removed for it.
+		if (!count)
+			return size();
+
+		std::optional<size_t> oFirstIndex = m_indicesManager.AllocateRange(count, policy);
+
+		if (oFirstIndex)
+			return oFirstIndex.value();
+
+		// If there isn't a large enough range, the new range should start with the free
+		// indices at the end. So, only the missing ones need to be allocated.
+		const size_t firstIndex = size() - m_indicesManager.GetTrailingAvailableCount();
+
+		Resize(firstIndex + count);
+
+		m_indicesManager.ToggleAvailability(firstIndex, count, false);
+
+		return firstIndex;
+	}
+
+private:
+	Container_t               m_elements;
+	IndicesManager_t          m_indicesManager;
+	DirtyWords_t              m_dirtyWords;
+	bool                      m_dirtyTrackingEnabled;
+	std::optional<TrimPolicy> m_trimPolicy;
 
 public:
 	ReusableContainer(const ReusableContainer& other) noexcept
-		: m_elements{ other.m_elements }, m_indicesManager{ other.m_indicesManager }
+		: m_elements{ other.m_elements }, m_indicesManager{ other.m_indicesManager },
+		m_dirtyWords{ other.m_dirtyWords }, m_dirtyTrackingEnabled{ other.m_dirtyTrackingEnabled },
+		m_trimPolicy{ other.m_trimPolicy }
 	{}
 	ReusableContainer& operator=(const ReusableContainer& other) noexcept
 	{
-		m_elements       = other.m_elements;
-		m_indicesManager = other.m_indicesManager;
+		m_elements             = other.m_elements;
+		m_indicesManager       = other.m_indicesManager;
+		m_dirtyWords           = other.m_dirtyWords;
+		m_dirtyTrackingEnabled = other.m_dirtyTrackingEnabled;
+		m_trimPolicy           = other.m_trimPolicy;
 
 		return *this;
 	}
 	ReusableContainer(ReusableContainer&& other) noexcept
 		: m_elements{ std::move(other.m_elements) },
-		m_indicesManager{ std::move(other.m_indicesManager) }
+		m_indicesManager{ std::move(other.m_indicesManager) },
+		m_dirtyWords{ std::move(other.m_dirtyWords) },
+		m_dirtyTrackingEnabled{ other.m_dirtyTrackingEnabled },
+		m_trimPolicy{ other.m_trimPolicy }
 	{}
 	ReusableContainer& operator=(ReusableContainer&& other) noexcept
 	{
-		m_elements       = std::move(other.m_elements);
-		m_indicesManager = std::move(other.m_indicesManager);
+		m_elements             = std::move(other.m_elements);
+		m_indicesManager       = std::move(other.m_indicesManager);
+		m_dirtyWords           = std::move(other.m_dirtyWords);
+		m_dirtyTrackingEnabled = other.m_dirtyTrackingEnabled;
+		m_trimPolicy           = other.m_trimPolicy;
 
 		return *this;
 	}
@@ -220,5 +911,17 @@ using ReusableVector = ReusableContainer<T, std::vector<T>>;
 
 template<typename T>
 using ReusableDeque = ReusableContainer<T, std::deque<T>>;
+
+template<typename T, size_t pageSize = 1024u>
+using ReusablePagedVector = ReusableContainer<T, PagedVector<T, pageSize>>;
+
+namespace pmr
+{
+template<typename T>
+using ReusableVector = ReusableContainer<T, std::pmr::vector<T>>;
+
+template<typename T>
+using ReusableDeque = ReusableContainer<T, std::pmr::deque<T>>;
+}
 }
 #endif
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <vector>
 #include <optional>
+#include <limits>
+#include <DefragmentationMove.hpp>
 
 class SharedBufferAllocatorTest;
 
@@ -20,7 +22,7 @@ public:
 	};
 
 public:
-	SharedBufferAllocator() : m_availableMemory{} {}
+	SharedBufferAllocator() : m_availableMemory{}, m_deferredMemory{} {}
 
 	[[nodiscard]]
 	// The offset from the start of the buffer will be returned. Should make sure
@@ -33,30 +35,63 @@ public:
 		AddAllocInfo(offset, size);
 	}
 
+	// The memory will only be available once the frame has been retired. So, memory which is
+	// still being used by the GPU can be relinquished.
+	void DeferRelinquish(size_t offset, size_t size, size_t frameIndex) noexcept;
+	// Relinquishes all of the memory which was deferred with this frameIndex.
+	void RetireFrame(size_t frameIndex) noexcept;
+
 	[[nodiscard]]
 	std::optional<size_t> GetAvailableAllocInfo(size_t size) const noexcept;
 	[[nodiscard]]
 	AllocInfo GetAndRemoveAllocInfo(size_t index) noexcept;
 
+	[[nodiscard]]
+	// Slides the live memory towards the start of the buffer, so the free blocks are merged into
+	// a single block. The moves must be executed in the returned order, before the moved memory
+	// is used again; the allocator's state is updated as if they have already been done.
+	// A live range which is larger than the free block before it is moved in pieces of that
+	// block's size, so the source and the destination of a single move don't overlap. But a
+	// move can write over the source of the move before it, so there must be a barrier
+	// between the copies. At most byteBudget bytes and maxMoveCount moves are returned. If
+	// they run out in the middle of a range, the next call continues from there.
+	// The memory after the last free block isn't moved, as its size isn't known here. Neither is
+	// any live memory which contains deferred memory, as that memory is still in use.
+	std::vector<DefragmentationMove> Defragment(
+		size_t byteBudget, size_t maxMoveCount = std::numeric_limits<size_t>::max()
+	) noexcept;
+
+private:
+	void InsertAllocInfo(size_t offset, size_t size) noexcept;
+
+	[[nodiscard]]
+	size_t GetLowestDeferredOffset() const noexcept;
+
 private:
-	std::vector<AllocInfo> m_availableMemory;
+	std::vector<AllocInfo>              m_availableMemory;
+	// One bucket per frame index.
+	std::vector<std::vector<AllocInfo>> m_deferredMemory;
 
 public:
 	SharedBufferAllocator(const SharedBufferAllocator& other) noexcept
-		: m_availableMemory{ other.m_availableMemory }
+		: m_availableMemory{ other.m_availableMemory },
+		m_deferredMemory{ other.m_deferredMemory }
 	{}
 	SharedBufferAllocator& operator=(const SharedBufferAllocator& other) noexcept
 	{
 		m_availableMemory = other.m_availableMemory;
+		m_deferredMemory  = other.m_deferredMemory;
 
 		return *this;
 	}
 	SharedBufferAllocator(SharedBufferAllocator&& other) noexcept
-		: m_availableMemory{ std::move(other.m_availableMemory) }
+		: m_availableMemory{ std::move(other.m_availableMemory) },
+		m_deferredMemory{ std::move(other.m_deferredMemory) }
 	{}
 	SharedBufferAllocator& operator=(SharedBufferAllocator&& other) noexcept
 	{
 		m_availableMemory = std::move(other.m_availableMemory);
+		m_deferredMemory  = std::move(other.m_deferredMemory);
 
 		return *this;
 	}
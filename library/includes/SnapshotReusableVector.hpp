@@ -0,0 +1,193 @@
+#ifndef CALLISTO_SNAPSHOT_REUSABLE_VECTOR_HPP_
+#define CALLISTO_SNAPSHOT_REUSABLE_VECTOR_HPP_
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <optional>
+#include <algorithm>
+#include <utility>
+#include <IndicesManager.hpp>
+
+namespace Callisto
+{
+// A ReusableVector for a single writer and any number of readers on other threads. The writer
+// changes its own working copy and calls Publish, and the readers get the last published
+// snapshot, which won't ever change. The elements are stored in pages which are shared
+// between the working copy and the snapshots, and a page is only copied when the writer
+// changes it while a snapshot still has it. So, publishing only copies the page pointers and
+// the availability words.
+template<typename T, size_t pageSize = 1024u>
+class SnapshotReusableVector
+{
+	static_assert(std::has_single_bit(pageSize), "The page size must be a 2s exponent.");
+
+	static constexpr size_t s_pageShift = static_cast<size_t>(std::countr_zero(pageSize));
+	static constexpr size_t s_pageMask  = pageSize - 1u;
+
+public:
+	// A published state of the vector. It is never changed, so it can be read from any thread.
+	class Snapshot
+	{
+	public:
+		Snapshot(
+			std::vector<std::shared_ptr<const T[]>>&& pages, const IndicesManager& indicesManager,
+			size_t elementCount
+		) : m_pages{ std::move(pages) }, m_indicesManager{ indicesManager },
+			m_elementCount{ elementCount }
+		{}
+
+		const T& operator[](size_t index) const noexcept
+		{
+			return m_pages[index >> s_pageShift][index & s_pageMask];
+		}
+
+		[[nodiscard]]
+		bool IsInUse(size_t index) const noexcept { return m_indicesManager.IsInUse(index); }
+
+		[[nodiscard]]
+		// The indices of the elements which are in use.
+		auto GetActiveIndices() const noexcept { return m_indicesManager.GetInUseIndices(); }
+
+		size_t size() const noexcept { return m_elementCount; }
+
+	private:
+		std::vector<std::shared_ptr<const T[]>> m_pages;
+		IndicesManager                          m_indicesManager;
+		size_t                                  m_elementCount;
+	};
+
+public:
+	SnapshotReusableVector()
+		: m_pages{}, m_indicesManager{}, m_elementCount{ 0u }, m_publishedSnapshot{}
+	{
+		Publish();
+	}
+	SnapshotReusableVector(size_t initialSize) : SnapshotReusableVector{}
+	{
+		Resize(initialSize);
+		Publish();
+	}
+
+	// To use this, T must have a default ctor.
+	void Resize(size_t newTotalCount)
+	{
+		// The removed elements are reset, so they would be default constructed if it grows
+		// again.
+		for (size_t index = newTotalCount; index < m_elementCount; ++index)
+			Modify(index) = T{};
+
+		const size_t requiredPageCount = (newTotalCount + s_pageMask) >> s_pageShift;
+
+		for (size_t pageIndex = std::size(m_pages); pageIndex < requiredPageCount; ++pageIndex)
+			m_pages.emplace_back(std::make_shared<T[]>(pageSize));
+
+		m_indicesManager.Resize(newTotalCount);
+
+		m_elementCount = newTotalCount;
+	}
+
+	template<typename U>
+	// To use this, T must have a copy and a default ctor for the reserving.
+	size_t Add(U&& element, size_t extraAllocCount = 0)
+	{
+		size_t elementIndex                 = std::numeric_limits<size_t>::max();
+		std::optional<size_t> oElementIndex = m_indicesManager.GetFirstAvailableIndex();
+
+		if (oElementIndex)
+			elementIndex = oElementIndex.value();
+		else
+		{
+			elementIndex = m_elementCount;
+
+			Resize(elementIndex + 1u + extraAllocCount);
+		}
+
+		Modify(elementIndex) = std::forward<U>(element);
+		m_indicesManager.ToggleAvailability(elementIndex, false);
+
+		return elementIndex;
+	}
+
+	void RemoveElement(size_t index)
+	{
+		Modify(index) = T{};
+		m_indicesManager.ToggleAvailability(index, true);
+	}
+
+	[[nodiscard]]
+	// Returns the element in the working copy to write to. If a snapshot still has its page,
+	// the page is copied first.
+	T& Modify(size_t index)
+	{
+		std::shared_ptr<T[]>& page = m_pages[index >> s_pageShift];
+
+		// Only the writer can add a new owner, so if it is the only owner it will stay that
+		// way. If a reader releases a snapshot at the same time, the page might be copied
+		// needlessly, which is still safe.
+		if (page.use_count() > 1)
+		{
+			auto pageCopy = std::make_shared_for_overwrite<T[]>(pageSize);
+
+			std::copy(page.get(), page.get() + pageSize, pageCopy.get());
+
+			page = std::move(pageCopy);
+		}
+		else
+		{
+			// use_count is a relaxed load, so it doesn't synchronise with the reader which
+			// dropped the last snapshot with this page. The release decrement of that reader
+			// pairs with this fence, so its reads of the page happen before our write.
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+
+		return page[index & s_pageMask];
+	}
+
+	// The working copy can be read without any copying.
+	const T& operator[](size_t index) const noexcept
+	{
+		return m_pages[index >> s_pageShift][index & s_pageMask];
+	}
+
+	[[nodiscard]]
+	bool IsInUse(size_t index) const noexcept { return m_indicesManager.IsInUse(index); }
+
+	size_t size() const noexcept { return m_elementCount; }
+
+	// Makes the current working copy visible to the readers.
+	void Publish()
+	{
+		std::vector<std::shared_ptr<const T[]>> pages{ std::begin(m_pages), std::end(m_pages) };
+
+		m_publishedSnapshot.store(
+			std::make_shared<const Snapshot>(std::move(pages), m_indicesManager, m_elementCount),
+			std::memory_order_release
+		);
+	}
+
+	[[nodiscard]]
+	// Can be called from any thread. The snapshot will stay the same as long as it is kept.
+	std::shared_ptr<const Snapshot> GetSnapshot() const noexcept
+	{
+		return m_publishedSnapshot.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]]
+	const IndicesManager& GetIndicesManager() const noexcept { return m_indicesManager; }
+
+private:
+	std::vector<std::shared_ptr<T[]>>            m_pages;
+	IndicesManager                               m_indicesManager;
+	size_t                                       m_elementCount;
+	std::atomic<std::shared_ptr<const Snapshot>> m_publishedSnapshot;
+
+public:
+	SnapshotReusableVector(const SnapshotReusableVector&) = delete;
+	SnapshotReusableVector& operator=(const SnapshotReusableVector&) = delete;
+	SnapshotReusableVector(SnapshotReusableVector&&) = delete;
+	SnapshotReusableVector& operator=(SnapshotReusableVector&&) = delete;
+};
+}
+#endif
@@ -0,0 +1,139 @@
+#ifndef CALLISTO_TEMPORARY_ARENA_HPP_
+#define CALLISTO_TEMPORARY_ARENA_HPP_
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+namespace Callisto
+{
+// Allocates by bumping an offset in large chunks, and everything is released at once with
+// Reset. The objects are owned by the arena, so there is no refcounting, and only the objects
+// which aren't trivially destructible have their destructors stored.
+class TemporaryArena
+{
+	struct Chunk
+	{
+		std::unique_ptr<std::byte[]> memory;
+		size_t                       size;
+		size_t                       usedSize;
+	};
+
+	struct Destructor
+	{
+		void (*destroy)(void*) noexcept;
+		void* object;
+	};
+
+public:
+	static constexpr size_t s_defaultChunkSize = 64u * 1024u;
+
+public:
+	TemporaryArena(size_t chunkSize = s_defaultChunkSize)
+		: m_chunks{}, m_destructors{}, m_chunkSize{ chunkSize }, m_currentChunkIndex{ 0u },
+		m_allocatedSize{ 0u }, m_reservedSize{ 0u }
+	{}
+	~TemporaryArena() noexcept;
+
+	[[nodiscard]]
+	// The memory will be available until the arena is reset.
+	void* AllocateBytes(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	template<typename T, typename... Args>
+	// The object will be destroyed when the arena is reset.
+	T* Emplace(Args&&... args)
+	{
+		void* memory = AllocateBytes(sizeof(T), alignof(T));
+
+		// Reserve first, so adding the destructor after constructing the object can't throw.
+		// The capacity is doubled, so it is only reallocated when it is full.
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			if (std::size(m_destructors) == m_destructors.capacity())
+				m_destructors.reserve(std::max(size_t{ 16u }, 2u * std::size(m_destructors)));
+
+		T* object = ::new(memory) T(std::forward<Args>(args)...);
+
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			m_destructors.emplace_back(
+				Destructor{
+					.destroy = [](void* object) noexcept { static_cast<T*>(object)->~T(); },
+					.object  = object
+				}
+			);
+
+		return object;
+	}
+
+	// Destroys the objects in the reverse order of their creation. The chunks are kept to be
+	// reused, except the ones larger than the chunk size, which were made for a single large
+	// block. Otherwise, a burst of large blocks would be kept for the lifetime of the arena.
+	void Reset() noexcept;
+
+	// Takes the chunks and the objects of the other arena, which will be empty afterwards.
+	void Splice(TemporaryArena& other);
+
+	[[nodiscard]]
+	// The number of bytes which have been allocated since the last reset, including the
+	// alignment padding.
+	size_t GetAllocatedSize() const noexcept { return m_allocatedSize; }
+
+	[[nodiscard]]
+	bool IsEmpty() const noexcept { return !m_allocatedSize; }
+
+	[[nodiscard]]
+	// The total size of the chunks, which is the memory the arena actually holds.
+	size_t GetReservedSize() const noexcept { return m_reservedSize; }
+
+	[[nodiscard]]
+	// The size of the chunk which would be allocated for the block, or 0 if it fits in the
+	// current chunks.
+	size_t GetNewChunkSize(
+		size_t size, size_t alignment = alignof(std::max_align_t)
+	) const noexcept;
+
+private:
+	[[nodiscard]]
+	static size_t GetPadding(const Chunk& chunk, size_t alignment) noexcept;
+
+	[[nodiscard]]
+	static void* TryAllocate(Chunk& chunk, size_t size, size_t alignment) noexcept;
+
+private:
+	std::vector<Chunk>      m_chunks;
+	std::vector<Destructor> m_destructors;
+	size_t                  m_chunkSize;
+	size_t                  m_currentChunkIndex;
+	size_t                  m_allocatedSize;
+	size_t                  m_reservedSize;
+
+public:
+	TemporaryArena(const TemporaryArena&) = delete;
+	TemporaryArena& operator=(const TemporaryArena&) = delete;
+
+	TemporaryArena(TemporaryArena&& other) noexcept
+		: m_chunks{ std::move(other.m_chunks) }, m_destructors{ std::move(other.m_destructors) },
+		m_chunkSize{ other.m_chunkSize },
+		m_currentChunkIndex{ std::exchange(other.m_currentChunkIndex, 0u) },
+		m_allocatedSize{ std::exchange(other.m_allocatedSize, 0u) },
+		m_reservedSize{ std::exchange(other.m_reservedSize, 0u) }
+	{}
+	TemporaryArena& operator=(TemporaryArena&& other) noexcept
+	{
+		// The current objects must be destroyed before their memory is released.
+		Reset();
+
+		m_chunks            = std::move(other.m_chunks);
+		m_destructors       = std::move(other.m_destructors);
+		m_chunkSize         = other.m_chunkSize;
+		m_currentChunkIndex = std::exchange(other.m_currentChunkIndex, 0u);
+		m_allocatedSize     = std::exchange(other.m_allocatedSize, 0u);
+		m_reservedSize      = std::exchange(other.m_reservedSize, 0u);
+
+		return *this;
+	}
+};
+}
+#endif
@@ -2,78 +2,288 @@
 #define CALLISTO_TEMPORARY_DATA_BUFFER_HPP_
 #include <vector>
 #include <memory>
+#include <limits>
+#include <atomic>
+#include <functional>
+#include <utility>
+#include <TemporaryArena.hpp>
+#include <TemporaryDataReclaimer.hpp>
 
 namespace Callisto
 {
+// A lock-free list which any number of threads can add to, and a single thread can take the
+// whole list from with one exchange.
+class TemporaryDataList
+{
+	struct Node
+	{
+		std::shared_ptr<void> data;
+		size_t                byteSize;
+		Node*                 next;
+	};
+
+public:
+	TemporaryDataList() : m_head{ nullptr } {}
+	~TemporaryDataList() noexcept;
+
+	// Can be called from any thread.
+	void Add(std::shared_ptr<void> data, size_t byteSize = 0u);
+
+	// Moves the added data to the end of buffers, in the order they were added, and returns
+	// the sum of their byte sizes. Should only be called from one thread at a time.
+	size_t MoveTo(std::vector<std::shared_ptr<void>>& buffers);
+
+	// Releases the added data. Should only be called from one thread at a time.
+	void Clear() noexcept;
+
+	[[nodiscard]]
+	bool IsEmpty() const noexcept { return m_head.load(std::memory_order_acquire) == nullptr; }
+
+private:
+	[[nodiscard]]
+	// Takes every node, with the first added one being the first.
+	Node* TakeNodes() noexcept;
+
+	static void DestroyNodes(Node* nodes) noexcept;
+
+private:
+	std::atomic<Node*> m_head;
+
+public:
+	TemporaryDataList(const TemporaryDataList&) = delete;
+	TemporaryDataList& operator=(const TemporaryDataList&) = delete;
+
+	// Moving isn't thread-safe.
+	TemporaryDataList(TemporaryDataList&& other) noexcept
+		: m_head{ other.m_head.exchange(nullptr) }
+	{}
+	TemporaryDataList& operator=(TemporaryDataList&& other) noexcept
+	{
+		DestroyNodes(m_head.exchange(other.m_head.exchange(nullptr)));
+
+		return *this;
+	}
+};
+
+// Add can be called from any thread, but Emplace, AllocateBytes and Clear must be called from
+// the same one.
 class TemporaryDataBufferCPU
 {
 public:
-	TemporaryDataBufferCPU() : m_tempBuffer{} {};
+	TemporaryDataBufferCPU() : m_tempBuffer{}, m_arena{} {};
 
+	// Should only be used if the ownership of the data is actually shared. Otherwise, use
+	// Emplace or AllocateBytes, which don't need any refcounting.
 	void Add(std::shared_ptr<void> tempData) noexcept
 	{
-		m_tempBuffer.emplace_back(std::move(tempData));
+		m_tempBuffer.Add(std::move(tempData));
+	}
+
+	template<typename T, typename... Args>
+	// The object will be alive until the buffer is cleared.
+	T* Emplace(Args&&... args)
+	{
+		return m_arena.Emplace<T>(std::forward<Args>(args)...);
 	}
 
-	void Clear() noexcept { m_tempBuffer.clear(); }
+	[[nodiscard]]
+	void* AllocateBytes(size_t size, size_t alignment = alignof(std::max_align_t))
+	{
+		return m_arena.AllocateBytes(size, alignment);
+	}
+
+	void Clear() noexcept
+	{
+		m_tempBuffer.Clear();
+		m_arena.Reset();
+	}
 
 private:
-	std::vector<std::shared_ptr<void>> m_tempBuffer;
+	TemporaryDataList m_tempBuffer;
+	TemporaryArena    m_arena;
 
 public:
 	TemporaryDataBufferCPU(const TemporaryDataBufferCPU&) = delete;
 	TemporaryDataBufferCPU& operator=(const TemporaryDataBufferCPU&) = delete;
 
 	TemporaryDataBufferCPU(TemporaryDataBufferCPU&& other) noexcept
-		: m_tempBuffer{ std::move(other.m_tempBuffer) }
+		: m_tempBuffer{ std::move(other.m_tempBuffer) }, m_arena{ std::move(other.m_arena) }
 	{}
 	TemporaryDataBufferCPU& operator=(TemporaryDataBufferCPU&& other) noexcept
 	{
 		m_tempBuffer = std::move(other.m_tempBuffer);
+		m_arena      = std::move(other.m_arena);
 
 		return *this;
 	}
 };
 
+// The added buffers are pending until SetUsed is called, which moves them to the bucket of
+// that frame. And Clear only releases the bucket of its frame, so neither of them needs to go
+// through the buffers of the other frames.
+// Add can be called from any thread, and SetUsed takes everything which was added before it
+// with one exchange. The other functions must be called from the same thread.
 class TemporaryDataBufferGPU
 {
-private:
-	struct TempBuffer
-	{
-		std::shared_ptr<void> buffer;
-		size_t                ownerIndex;
-	};
+public:
+	// Is called with the held bytes and the size of the data which went or would go over the
+	// budget. It shouldn't throw.
+	using BudgetCallback_t = std::function<void(size_t heldBytes, size_t byteSize)>;
 
 public:
-	TemporaryDataBufferGPU() : m_tempBuffers{} {}
+	TemporaryDataBufferGPU()
+		: m_pendingList{}, m_pendingBucket{}, m_frameBuckets{}, m_reclaimer{}, m_heldBytes{ 0u },
+		m_budget{ std::numeric_limits<size_t>::max() }, m_budgetCallback{}
+	{}
 
-	void Add(std::shared_ptr<void> tempData) noexcept
+	// Should only be used if the ownership of the data is actually shared. Otherwise, use
+	// Emplace or AllocateBytes, which don't need any refcounting.
+	// The data is always added, but the budget callback is called if it goes over the budget.
+	// If byteSize is 0, the data isn't counted in the held bytes.
+	void Add(std::shared_ptr<void> tempData, size_t byteSize = 0u) noexcept
+	{
+		ReserveBytes(byteSize);
+		m_pendingList.Add(std::move(tempData), byteSize);
+	}
+
+	[[nodiscard]]
+	// Only adds the data if the held bytes wouldn't go over the budget. Otherwise, the budget
+	// callback is called and false is returned, so the caller can try again later. Can be
+	// called from any thread.
+	bool TryAdd(std::shared_ptr<void> tempData, size_t byteSize);
+
+	template<typename T, typename... Args>
+	// The object will be alive until the frame it is used in is cleared. Like Add, the budget
+	// callback is called if a new chunk goes over the budget.
+	T* Emplace(Args&&... args)
+	{
+		ReserveBytes(m_pendingBucket.arena.GetNewChunkSize(sizeof(T), alignof(T)));
+
+		return m_pendingBucket.arena.Emplace<T>(std::forward<Args>(args)...);
+	}
+
+	template<typename T, typename... Args>
+	[[nodiscard]]
+	// Returns nullptr if a new chunk would go over the budget.
+	T* TryEmplace(Args&&... args)
+	{
+		if (!TryReserveBytes(m_pendingBucket.arena.GetNewChunkSize(sizeof(T), alignof(T))))
+			return nullptr;
+
+		return m_pendingBucket.arena.Emplace<T>(std::forward<Args>(args)...);
+	}
+
+	[[nodiscard]]
+	void* AllocateBytes(size_t size, size_t alignment = alignof(std::max_align_t))
+	{
+		ReserveBytes(m_pendingBucket.arena.GetNewChunkSize(size, alignment));
+
+		return m_pendingBucket.arena.AllocateBytes(size, alignment);
+	}
+
+	[[nodiscard]]
+	// Returns nullptr if a new chunk would go over the budget.
+	void* TryAllocateBytes(size_t size, size_t alignment = alignof(std::max_align_t))
 	{
-		m_tempBuffers.emplace_back(
-			TempBuffer{
-				.buffer     = std::move(tempData),
-				.ownerIndex = std::numeric_limits<size_t>::max()
-			}
-		);
+		if (!TryReserveBytes(m_pendingBucket.arena.GetNewChunkSize(size, alignment)))
+			return nullptr;
+
+		return m_pendingBucket.arena.AllocateBytes(size, alignment);
 	}
 
-	void SetUsed(size_t frameIndex) noexcept;
+	void SetUsed(size_t frameIndex);
 
 	void Clear(size_t frameIndex) noexcept;
 
+	// After this, the cleared buckets are destroyed on a worker thread. If the memory which
+	// hasn't been freed yet would go over maxOutstandingBytes, the bucket is destroyed in
+	// Clear instead.
+	void EnableBackgroundReclaim(
+		size_t maxOutstandingBytes = std::numeric_limits<size_t>::max()
+	);
+	// Waits for the worker to destroy the cleared buckets and stops it.
+	void DisableBackgroundReclaim() noexcept { m_reclaimer.reset(); }
+
+	[[nodiscard]]
+	bool IsBackgroundReclaimEnabled() const noexcept { return m_reclaimer != nullptr; }
+
+	// Waits until the cleared buckets are destroyed. Should be called before anything which
+	// the temporary data depends on is destroyed.
+	void Flush() noexcept;
+
+	// The callback should only be set before any other thread calls Add or TryAdd.
+	void SetBudget(size_t budget, BudgetCallback_t callback = {})
+	{
+		m_budget.store(budget, std::memory_order_relaxed);
+		m_budgetCallback = std::move(callback);
+	}
+
+	[[nodiscard]]
+	size_t GetBudget() const noexcept { return m_budget.load(std::memory_order_relaxed); }
+
+	[[nodiscard]]
+	// The bytes held by a frame. The arena chunks a cleared frame keeps for reuse are
+	// included. The pending data isn't.
+	size_t GetHeldBytes(size_t frameIndex) const noexcept;
+
+	[[nodiscard]]
+	// The bytes held by every frame and the pending data, including the arena chunks. This
+	// is what the budget is checked against. The buckets given to the background reclaimer
+	// aren't included, even before the worker destroys them, so the memory in use can be
+	// higher by up to the maxOutstandingBytes of EnableBackgroundReclaim. Can be called from
+	// any thread.
+	size_t GetTotalHeldBytes() const noexcept
+	{
+		return m_heldBytes.load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]]
+	// The bytes of the cleared buckets which the background reclaimer hasn't destroyed yet.
+	size_t GetReclaimingBytes() const noexcept
+	{
+		return m_reclaimer ? m_reclaimer->GetOutstandingBytes() : 0u;
+	}
+
+private:
+	[[nodiscard]]
+	// Only reserves the bytes if they don't go over the budget. Otherwise, the budget callback
+	// is called.
+	bool TryReserveBytes(size_t byteSize) noexcept;
+
+	// Always reserves the bytes, but calls the budget callback if they go over the budget.
+	void ReserveBytes(size_t byteSize) noexcept;
+
 private:
-	std::vector<TempBuffer> m_tempBuffers;
+	TemporaryDataList                       m_pendingList;
+	TemporaryDataBucket                     m_pendingBucket;
+	// The data used by each frame in flight.
+	std::vector<TemporaryDataBucket>        m_frameBuckets;
+	std::unique_ptr<TemporaryDataReclaimer> m_reclaimer;
+	std::atomic<size_t>                     m_heldBytes;
+	std::atomic<size_t>                     m_budget;
+	BudgetCallback_t                        m_budgetCallback;
 
 public:
 	TemporaryDataBufferGPU(const TemporaryDataBufferGPU&) = delete;
 	TemporaryDataBufferGPU& operator=(const TemporaryDataBufferGPU&) = delete;
 
 	TemporaryDataBufferGPU(TemporaryDataBufferGPU&& other) noexcept
-		: m_tempBuffers{ std::move(other.m_tempBuffers) }
+		: m_pendingList{ std::move(other.m_pendingList) },
+		m_pendingBucket{ std::move(other.m_pendingBucket) },
+		m_frameBuckets{ std::move(other.m_frameBuckets) },
+		m_reclaimer{ std::move(other.m_reclaimer) },
+		m_heldBytes{ other.m_heldBytes.exchange(0u) }, m_budget{ other.m_budget.load() },
+		m_budgetCallback{ std::move(other.m_budgetCallback) }
 	{}
 	TemporaryDataBufferGPU& operator=(TemporaryDataBufferGPU&& other) noexcept
 	{
-		m_tempBuffers = std::move(other.m_tempBuffers);
+		m_pendingList   = std::move(other.m_pendingList);
+		m_pendingBucket = std::move(other.m_pendingBucket);
+		m_frameBuckets  = std::move(other.m_frameBuckets);
+		m_reclaimer     = std::move(other.m_reclaimer);
+		m_heldBytes.store(other.m_heldBytes.exchange(0u));
+		m_budget.store(other.m_budget.load());
+		m_budgetCallback = std::move(other.m_budgetCallback);
 
 		return *this;
 	}
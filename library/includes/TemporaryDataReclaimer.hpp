@@ -0,0 +1,86 @@
+#ifndef CALLISTO_TEMPORARY_DATA_RECLAIMER_HPP_
+#define CALLISTO_TEMPORARY_DATA_RECLAIMER_HPP_
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <limits>
+#include <cstdint>
+#include <TemporaryArena.hpp>
+
+namespace Callisto
+{
+// The shared buffers and the arena of the objects of a frame.
+struct TemporaryDataBucket
+{
+	std::vector<std::shared_ptr<void>> buffers;
+	TemporaryArena                     arena;
+	// The sizes the shared buffers were added with.
+	size_t                             bufferByteSize = 0u;
+
+	[[nodiscard]]
+	bool IsEmpty() const noexcept { return std::empty(buffers) && arena.IsEmpty(); }
+
+	[[nodiscard]]
+	// The arena's chunks are counted even if they are empty, as they are still allocated.
+	size_t GetHeldBytes() const noexcept { return bufferByteSize + arena.GetReservedSize(); }
+};
+
+// Destroys the given buckets on a worker thread, so freeing a lot of memory doesn't stall the
+// thread which clears them. The buckets are pushed to a lock-free stack, and the worker takes
+// the whole stack at once.
+// The outstanding bytes are bounded. If a bucket would go over the bound, it is destroyed on
+// the calling thread instead.
+class TemporaryDataReclaimer
+{
+	struct Node
+	{
+		TemporaryDataBucket bucket;
+		size_t              byteSize;
+		Node*               next;
+	};
+
+public:
+	TemporaryDataReclaimer(size_t maxOutstandingBytes = std::numeric_limits<size_t>::max());
+	~TemporaryDataReclaimer() noexcept;
+
+	// Can be called from any thread.
+	void Reclaim(TemporaryDataBucket&& bucket) noexcept;
+
+	// Waits until every bucket which has been given so far is destroyed.
+	void Flush() noexcept;
+
+	[[nodiscard]]
+	size_t GetOutstandingBytes() const noexcept
+	{
+		return m_outstandingBytes.load(std::memory_order_relaxed);
+	}
+	[[nodiscard]]
+	size_t GetMaxOutstandingBytes() const noexcept { return m_maxOutstandingBytes; }
+
+private:
+	void Run(std::stop_token stopToken) noexcept;
+
+	void DestroyNodes(Node* nodes) noexcept;
+
+	// Wakes the worker up.
+	void Signal() noexcept;
+
+private:
+	std::atomic<Node*>         m_head;
+	std::atomic<size_t>        m_outstandingBytes;
+	std::atomic<size_t>        m_outstandingNodeCount;
+	// Changed whenever the worker should wake up, so it can wait on it.
+	std::atomic<std::uint32_t> m_signal;
+	size_t                     m_maxOutstandingBytes;
+	// Must be the last member, as the thread uses the other ones.
+	std::jthread               m_worker;
+
+public:
+	TemporaryDataReclaimer(const TemporaryDataReclaimer&) = delete;
+	TemporaryDataReclaimer& operator=(const TemporaryDataReclaimer&) = delete;
+	TemporaryDataReclaimer(TemporaryDataReclaimer&&) = delete;
+	TemporaryDataReclaimer& operator=(TemporaryDataReclaimer&&) = delete;
+};
+}
+#endif
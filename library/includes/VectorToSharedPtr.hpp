@@ -2,19 +2,49 @@
 #define CALLISTO_SHARED_PTR_VECTOR_HPP_
 #include <vector>
 #include <memory>
+#include <ranges>
+#include <cstring>
+#include <cstdint>
 #include <type_traits>
 
 namespace Callisto
 {
+template<std::ranges::contiguous_range Range_t>
+requires std::ranges::sized_range<Range_t>
+	&& std::is_trivially_copyable_v<std::ranges::range_value_t<Range_t>>
+// Copies any contiguous range, like a vector, a span, an array or a C array.
+std::shared_ptr<std::uint8_t[]> CopyVectorToSharedPtr(const Range_t& container) noexcept
+{
+	using Element_t       = std::ranges::range_value_t<Range_t>;
+
+	const auto bufferSize = std::ranges::size(container) * sizeof(Element_t);
+
+	// The whole buffer will be overwritten, so it doesn't need to be zeroed first.
+	auto dataBuffer = std::make_shared_for_overwrite<std::uint8_t[]>(bufferSize);
+	std::memcpy(dataBuffer.get(), std::ranges::data(container), bufferSize);
+
+	return dataBuffer;
+}
+
 template<typename T>
+requires std::is_trivially_copyable_v<T>
 std::shared_ptr<std::uint8_t[]> CopyVectorToSharedPtr(const std::vector<T>& container) noexcept
 {
-	const auto bufferSize = std::size(container) * sizeof(T);
+	return CopyVectorToSharedPtr<std::vector<T>>(container);
+}
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+// Doesn't copy anything. The vector is moved into the control block, and the returned pointer
+// points to its data, so the vector is destroyed with the last owner. Its whole capacity is
+// kept alive, so it should be shrunk first if there is a lot of unused capacity.
+std::shared_ptr<std::uint8_t[]> MoveVectorToSharedPtr(std::vector<T>&& container)
+{
+	auto vectorOwner = std::make_shared<std::vector<T>>(std::move(container));
 
-	auto dataBuffer = std::make_shared<std::uint8_t[]>(bufferSize);
-	memcpy(dataBuffer.get(), std::data(container), bufferSize);
+	auto* data = reinterpret_cast<std::uint8_t*>(std::data(*vectorOwner));
 
-	return dataBuffer;
+	return std::shared_ptr<std::uint8_t[]>{ std::move(vectorOwner), data };
 }
 }
 #endif
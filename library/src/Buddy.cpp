@@ -1,6 +1,7 @@
 #include <Buddy.hpp>
 #include <CallistoException.hpp>
 #include <cassert>
+#include <numeric>
 
 namespace Callisto
 {
@@ -335,4 +336,59 @@ void Buddy::MergeBuddies(const AllocInfo64& buddy)
 	// Now make a new available block with the latest information.
 	MakeNewAvailableBlock(originalBuddyAddress, blockSize);
 }
+
+std::vector<DefragmentationMove> Buddy::Defragment(
+	std::span<LiveAllocation> liveAllocations, size_t byteBudget
+) noexcept {
+	std::vector<DefragmentationMove> moves{};
+	std::vector<LiveAllocation> oldAllocations{};
+
+	// Start from the highest address, as those are the ones which should be moved down.
+	std::vector<size_t> allocationOrder(std::size(liveAllocations));
+
+	std::iota(std::begin(allocationOrder), std::end(allocationOrder), 0u);
+	std::ranges::sort(
+		allocationOrder, std::ranges::greater{},
+		[liveAllocations](size_t index) { return liveAllocations[index].startingAddress; }
+	);
+
+	size_t movedBytes = 0u;
+
+	for (size_t allocationIndex : allocationOrder)
+	{
+		LiveAllocation& allocation = liveAllocations[allocationIndex];
+
+		// Smaller allocations might still fit in the rest of the budget.
+		if (movedBytes + allocation.size > byteBudget)
+			continue;
+
+		std::optional<size_t> newStartingAddress = AllocateN(allocation.size, allocation.alignment);
+
+		if (!newStartingAddress)
+			continue;
+
+		if (*newStartingAddress < allocation.startingAddress)
+		{
+			moves.emplace_back(
+				DefragmentationMove{
+					.srcOffset = allocation.startingAddress,
+					.dstOffset = *newStartingAddress,
+					.size      = allocation.size
+				}
+			);
+
+			oldAllocations.emplace_back(allocation);
+
+			allocation.startingAddress = *newStartingAddress;
+			movedBytes                += allocation.size;
+		}
+		else
+			Deallocate(*newStartingAddress, allocation.size, allocation.alignment);
+	}
+
+	for (const LiveAllocation& oldAllocation : oldAllocations)
+		Deallocate(oldAllocation.startingAddress, oldAllocation.size, oldAllocation.alignment);
+
+	return moves;
+}
 }
@@ -1,6 +1,7 @@
 #include <SharedBufferAllocator.hpp>
 #include <ranges>
 #include <algorithm>
+#include <limits>
 
 namespace Callisto
 {
@@ -55,6 +56,11 @@ void SharedBufferAllocator::AddAllocInfo(size_t offset, size_t size) noexcept
 		size += nextBlock.size;
 	}
 
+	InsertAllocInfo(offset, size);
+}
+
+void SharedBufferAllocator::InsertAllocInfo(size_t offset, size_t size) noexcept
+{
 	auto result = std::ranges::upper_bound(
 		m_availableMemory, size, {},
 		[](const AllocInfo& info) { return info.size; }
@@ -85,6 +91,63 @@ SharedBufferAllocator::AllocInfo SharedBufferAllocator::GetAndRemoveAllocInfo(si
 	return allocInfo;
 }
 
+void SharedBufferAllocator::DeferRelinquish(size_t offset, size_t size, size_t frameIndex) noexcept
+{
+	if (frameIndex >= std::size(m_deferredMemory))
+		m_deferredMemory.resize(frameIndex + 1u);
+
+	m_deferredMemory[frameIndex].emplace_back(AllocInfo{ offset, size });
+}
+
+void SharedBufferAllocator::RetireFrame(size_t frameIndex) noexcept
+{
+	if (frameIndex >= std::size(m_deferredMemory))
+		return;
+
+	std::vector<AllocInfo>& deferredMemory = m_deferredMemory[frameIndex];
+
+	if (std::empty(deferredMemory))
+		return;
+
+	// Merge the adjacent blocks of this frame first, so the free blocks are only searched once
+	// per merged block instead of once per relinquished block.
+	std::ranges::sort(deferredMemory, {}, [](const AllocInfo& info) { return info.offset; });
+
+	AllocInfo mergedBlock = deferredMemory.front();
+
+	const size_t deferredBlockCount = std::size(deferredMemory);
+
+	for (size_t index = 1u; index < deferredBlockCount; ++index)
+	{
+		const AllocInfo& deferredBlock = deferredMemory[index];
+
+		if (mergedBlock.offset + mergedBlock.size == deferredBlock.offset)
+			mergedBlock.size += deferredBlock.size;
+		else
+		{
+			AddAllocInfo(mergedBlock.offset, mergedBlock.size);
+
+			mergedBlock = deferredBlock;
+		}
+	}
+
+	AddAllocInfo(mergedBlock.offset, mergedBlock.size);
+
+	// Clear instead of deallocating, as the bucket will be used again for the same frame.
+	deferredMemory.clear();
+}
+
+size_t SharedBufferAllocator::GetLowestDeferredOffset() const noexcept
+{
+	size_t lowestOffset = std::numeric_limits<size_t>::max();
+
+	for (const std::vector<AllocInfo>& deferredMemory : m_deferredMemory)
+		for (const AllocInfo& deferredBlock : deferredMemory)
+			lowestOffset = std::min(lowestOffset, deferredBlock.offset);
+
+	return lowestOffset;
+}
+
 size_t SharedBufferAllocator::AllocateMemory(const AllocInfo& allocInfo, size_t size) noexcept
 {
 	const size_t offset     = allocInfo.offset;
@@ -95,4 +158,85 @@ size_t SharedBufferAllocator::AllocateMemory(const AllocInfo& allocInfo, size_t
 
 	return offset;
 }
+
+std::vector<DefragmentationMove> SharedBufferAllocator::Defragment(
+	size_t byteBudget, size_t maxMoveCount
+) noexcept {
+	std::vector<DefragmentationMove> moves{};
+
+	// There is nothing to merge with a single free block.
+	if (std::size(m_availableMemory) < 2u)
+		return moves;
+
+	// The available memory is sorted by size, but to slide the live memory we need the free
+	// blocks sorted by their offsets.
+	std::vector<AllocInfo> freeBlocks = m_availableMemory;
+
+	std::ranges::sort(freeBlocks, {}, [](const AllocInfo& info) { return info.offset; });
+
+	size_t gapOffset          = freeBlocks[0].offset;
+	size_t gapSize            = freeBlocks[0].size;
+	size_t movedBytes         = 0u;
+	size_t nextFreeBlockIndex = 1u;
+
+	const size_t freeBlockCount       = std::size(freeBlocks);
+	const size_t lowestDeferredOffset = GetLowestDeferredOffset();
+
+	for (; nextFreeBlockIndex < freeBlockCount; ++nextFreeBlockIndex)
+	{
+		const AllocInfo& nextFreeBlock = freeBlocks[nextFreeBlockIndex];
+
+		// The free blocks are always merged, so everything between the gap and the next free
+		// block must be live memory.
+		size_t liveOffset = gapOffset + gapSize;
+		size_t liveSize   = nextFreeBlock.offset - liveOffset;
+
+		// The deferred memory might still be in use. So, it can't be moved.
+		if (lowestDeferredOffset < liveOffset + liveSize)
+			break;
+
+		// If the live memory is larger than the gap, it is moved in gap sized pieces, so the
+		// source and the destination of a move don't overlap. The gap slides forward by the
+		// size of each piece.
+		while (liveSize && std::size(moves) < maxMoveCount && movedBytes < byteBudget)
+		{
+			const size_t pieceSize = std::min({ gapSize, liveSize, byteBudget - movedBytes });
+
+			moves.emplace_back(
+				DefragmentationMove{
+					.srcOffset = liveOffset, .dstOffset = gapOffset, .size = pieceSize
+				}
+			);
+
+			movedBytes += pieceSize;
+			gapOffset  += pieceSize;
+			liveOffset += pieceSize;
+			liveSize   -= pieceSize;
+		}
+
+		// If the budget ran out in the middle of the live memory, the gap is left before the
+		// rest of it, so the next call can continue from there.
+		if (liveSize)
+			break;
+
+		// After the moves, the gap is right before the next free block. So, they can be
+		// merged.
+		gapSize += nextFreeBlock.size;
+	}
+
+	// The free blocks which were merged into the gap don't exist anymore. So, rebuild the
+	// available memory with the gap and the untouched blocks.
+	m_availableMemory.clear();
+
+	InsertAllocInfo(gapOffset, gapSize);
+
+	for (; nextFreeBlockIndex < freeBlockCount; ++nextFreeBlockIndex)
+	{
+		const AllocInfo& freeBlock = freeBlocks[nextFreeBlockIndex];
+
+		InsertAllocInfo(freeBlock.offset, freeBlock.size);
+	}
+
+	return moves;
+}
 }
@@ -0,0 +1,136 @@
+#include <TemporaryArena.hpp>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+
+namespace Callisto
+{
+TemporaryArena::~TemporaryArena() noexcept
+{
+	Reset();
+}
+
+size_t TemporaryArena::GetPadding(const Chunk& chunk, size_t alignment) noexcept
+{
+	// The memory of a chunk is only aligned to the default new alignment, so the padding must
+	// be calculated with the actual address.
+	const auto address = reinterpret_cast<std::uintptr_t>(chunk.memory.get() + chunk.usedSize);
+
+	return (alignment - address % alignment) % alignment;
+}
+
+void* TemporaryArena::TryAllocate(Chunk& chunk, size_t size, size_t alignment) noexcept
+{
+	const size_t padding = GetPadding(chunk, alignment);
+
+	if (chunk.usedSize + padding + size > chunk.size)
+		return nullptr;
+
+	void* memory    = chunk.memory.get() + chunk.usedSize + padding;
+
+	chunk.usedSize += padding + size;
+
+	return memory;
+}
+
+void* TemporaryArena::AllocateBytes(size_t size, size_t alignment)
+{
+	const size_t chunkCount = std::size(m_chunks);
+
+	// The chunks before the current one are considered full, so they aren't checked again
+	// until the arena is reset.
+	for (; m_currentChunkIndex < chunkCount; ++m_currentChunkIndex)
+	{
+		Chunk& chunk          = m_chunks[m_currentChunkIndex];
+		const size_t usedSize = chunk.usedSize;
+
+		if (void* memory = TryAllocate(chunk, size, alignment); memory)
+		{
+			m_allocatedSize += chunk.usedSize - usedSize;
+
+			return memory;
+		}
+	}
+
+	// A block larger than the chunk size gets a chunk of its own.
+	const size_t newChunkSize = GetNewChunkSize(size, alignment);
+
+	Chunk& newChunk = m_chunks.emplace_back(
+		Chunk{
+			.memory   = std::make_unique_for_overwrite<std::byte[]>(newChunkSize),
+			.size     = newChunkSize,
+			.usedSize = 0u
+		}
+	);
+
+	m_currentChunkIndex = std::size(m_chunks) - 1u;
+	m_reservedSize     += newChunkSize;
+
+	void* memory        = TryAllocate(newChunk, size, alignment);
+
+	m_allocatedSize    += newChunk.usedSize;
+
+	return memory;
+}
+
+size_t TemporaryArena::GetNewChunkSize(size_t size, size_t alignment) const noexcept
+{
+	for (size_t chunkIndex = m_currentChunkIndex; chunkIndex < std::size(m_chunks); ++chunkIndex)
+	{
+		const Chunk& chunk = m_chunks[chunkIndex];
+
+		if (chunk.usedSize + GetPadding(chunk, alignment) + size <= chunk.size)
+			return 0u;
+	}
+
+	return std::max(m_chunkSize, size + alignment - 1u);
+}
+
+void TemporaryArena::Reset() noexcept
+{
+	for (auto rIt = std::rbegin(m_destructors); rIt != std::rend(m_destructors); ++rIt)
+		rIt->destroy(rIt->object);
+
+	m_destructors.clear();
+
+	std::erase_if(
+		m_chunks,
+		[this](const Chunk& chunk) noexcept
+		{
+			if (chunk.size <= m_chunkSize)
+				return false;
+
+			m_reservedSize -= chunk.size;
+
+			return true;
+		}
+	);
+
+	for (Chunk& chunk : m_chunks)
+		chunk.usedSize = 0u;
+
+	m_currentChunkIndex = 0u;
+	m_allocatedSize     = 0u;
+}
+
+void TemporaryArena::Splice(TemporaryArena& other)
+{
+	m_chunks.insert(
+		std::end(m_chunks), std::make_move_iterator(std::begin(other.m_chunks)),
+		std::make_move_iterator(std::end(other.m_chunks))
+	);
+	m_destructors.insert(
+		std::end(m_destructors), std::begin(other.m_destructors), std::end(other.m_destructors)
+	);
+
+	m_allocatedSize += other.m_allocatedSize;
+	m_reservedSize  += other.m_reservedSize;
+
+	other.m_chunks.clear();
+	other.m_destructors.clear();
+
+	other.m_currentChunkIndex = 0u;
+	other.m_allocatedSize     = 0u;
+	other.m_reservedSize      = 0u;
+}
+}
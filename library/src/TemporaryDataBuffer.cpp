@@ -1,31 +1,203 @@
 #include <TemporaryDataBuffer.hpp>
+#include <iterator>
+#include <utility>
 
 namespace Callisto
 {
-void TemporaryDataBufferGPU::SetUsed(size_t frameIndex) noexcept
+TemporaryDataList::~TemporaryDataList() noexcept
 {
-	// The tempBuffer should be like a queue and the front of it should be already used.
-	// So, it should be a bit faster if I start marking the new resources used from the
-	// back.
-	for (auto rIt = std::rbegin(m_tempBuffers); rIt != std::rend(m_tempBuffers); ++rIt)
+	Clear();
+}
+
+void TemporaryDataList::Add(std::shared_ptr<void> data, size_t byteSize)
+{
+	Node* node = new Node{ std::move(data), byteSize, m_head.load(std::memory_order_relaxed) };
+
+	// Release, so the data is visible to the thread which takes the list.
+	while (!m_head.compare_exchange_weak(
+		node->next, node, std::memory_order_release, std::memory_order_relaxed
+	));
+}
+
+TemporaryDataList::Node* TemporaryDataList::TakeNodes() noexcept
+{
+	Node* nodes = m_head.exchange(nullptr, std::memory_order_acquire);
+
+	// The last added node is the head, so it is reversed.
+	Node* reversedList = nullptr;
+
+	while (nodes)
+	{
+		Node* next   = nodes->next;
+		nodes->next  = reversedList;
+		reversedList = nodes;
+		nodes        = next;
+	}
+
+	return reversedList;
+}
+
+size_t TemporaryDataList::MoveTo(std::vector<std::shared_ptr<void>>& buffers)
+{
+	Node* nodes = TakeNodes();
+
+	size_t nodeCount = 0u;
+	size_t byteSize  = 0u;
+
+	for (Node* node = nodes; node; node = node->next)
+	{
+		++nodeCount;
+		byteSize += node->byteSize;
+	}
+
+	buffers.reserve(std::size(buffers) + nodeCount);
+
+	for (Node* node = nodes; node; node = node->next)
+		buffers.emplace_back(std::move(node->data));
+
+	DestroyNodes(nodes);
+
+	return byteSize;
+}
+
+void TemporaryDataList::Clear() noexcept
+{
+	DestroyNodes(m_head.exchange(nullptr, std::memory_order_acquire));
+}
+
+void TemporaryDataList::DestroyNodes(Node* nodes) noexcept
+{
+	while (nodes)
 	{
-		TempBuffer& tempBuffer = *rIt;
+		Node* next = nodes->next;
 
-		// Once we have hit the first tempBuffer which has an owner, every next buffer
-		// should also have an owner. So, we shouldn't need to go any farther.
-		if (tempBuffer.ownerIndex != std::numeric_limits<size_t>::max())
-			break;
+		delete nodes;
 
-		tempBuffer.ownerIndex = frameIndex;
+		nodes = next;
+	}
+}
+
+void TemporaryDataBufferGPU::SetUsed(size_t frameIndex)
+{
+	m_pendingBucket.bufferByteSize += m_pendingList.MoveTo(m_pendingBucket.buffers);
+
+	if (frameIndex >= std::size(m_frameBuckets))
+		m_frameBuckets.resize(frameIndex + 1u);
+
+	TemporaryDataBucket& frameBucket = m_frameBuckets[frameIndex];
+
+	// The bucket should usually be empty, as it should have been cleared when the frame was
+	// finished. Then the pending data can be swapped in, and the pending bucket gets the
+	// capacity and the chunks of the cleared bucket.
+	if (frameBucket.IsEmpty())
+		std::swap(frameBucket, m_pendingBucket);
+	else
+	{
+		std::vector<std::shared_ptr<void>>& buffers = frameBucket.buffers;
+
+		buffers.insert(
+			std::end(buffers), std::make_move_iterator(std::begin(m_pendingBucket.buffers)),
+			std::make_move_iterator(std::end(m_pendingBucket.buffers))
+		);
+
+		m_pendingBucket.buffers.clear();
+
+		frameBucket.bufferByteSize += std::exchange(m_pendingBucket.bufferByteSize, 0u);
+
+		frameBucket.arena.Splice(m_pendingBucket.arena);
 	}
 }
 
 void TemporaryDataBufferGPU::Clear(size_t frameIndex) noexcept
 {
-	std::erase_if(
-		m_tempBuffers,
-		[frameIndex](const TempBuffer& tempBuffer)
-		{ return tempBuffer.ownerIndex == frameIndex; }
-	);
+	if (frameIndex < std::size(m_frameBuckets))
+	{
+		TemporaryDataBucket& frameBucket = m_frameBuckets[frameIndex];
+
+		const size_t heldBytes           = frameBucket.GetHeldBytes();
+
+		// The bucket's chunks and capacity go with it, as the point is to free the memory
+		// elsewhere.
+		if (m_reclaimer && !frameBucket.IsEmpty())
+			m_reclaimer->Reclaim(std::exchange(frameBucket, TemporaryDataBucket{}));
+		else
+		{
+			frameBucket.buffers.clear();
+			frameBucket.arena.Reset();
+
+			frameBucket.bufferByteSize = 0u;
+		}
+
+		// The kept chunks are still held.
+		m_heldBytes.fetch_sub(heldBytes - frameBucket.GetHeldBytes(), std::memory_order_relaxed);
+	}
+}
+
+bool TemporaryDataBufferGPU::TryAdd(std::shared_ptr<void> tempData, size_t byteSize)
+{
+	if (!TryReserveBytes(byteSize))
+		return false;
+
+	m_pendingList.Add(std::move(tempData), byteSize);
+
+	return true;
+}
+
+bool TemporaryDataBufferGPU::TryReserveBytes(size_t byteSize) noexcept
+{
+	if (!byteSize)
+		return true;
+
+	const size_t budget = m_budget.load(std::memory_order_relaxed);
+	size_t heldBytes    = m_heldBytes.load(std::memory_order_relaxed);
+
+	// The bytes are reserved first, so the other threads can't go over the budget at the same
+	// time.
+	do
+	{
+		if (byteSize > budget || heldBytes > budget - byteSize)
+		{
+			if (m_budgetCallback)
+				m_budgetCallback(heldBytes, byteSize);
+
+			return false;
+		}
+	} while (!m_heldBytes.compare_exchange_weak(
+		heldBytes, heldBytes + byteSize, std::memory_order_relaxed
+	));
+
+	return true;
+}
+
+void TemporaryDataBufferGPU::ReserveBytes(size_t byteSize) noexcept
+{
+	if (!byteSize)
+		return;
+
+	const size_t heldBytes = m_heldBytes.fetch_add(byteSize, std::memory_order_relaxed);
+
+	if (heldBytes + byteSize > m_budget.load(std::memory_order_relaxed) && m_budgetCallback)
+		m_budgetCallback(heldBytes, byteSize);
+}
+
+size_t TemporaryDataBufferGPU::GetHeldBytes(size_t frameIndex) const noexcept
+{
+	if (frameIndex < std::size(m_frameBuckets))
+		return m_frameBuckets[frameIndex].GetHeldBytes();
+
+	return 0u;
+}
+
+void TemporaryDataBufferGPU::EnableBackgroundReclaim(size_t maxOutstandingBytes)
+{
+	// Whatever the previous reclaimer has is destroyed before it is replaced.
+	m_reclaimer.reset();
+	m_reclaimer = std::make_unique<TemporaryDataReclaimer>(maxOutstandingBytes);
+}
+
+void TemporaryDataBufferGPU::Flush() noexcept
+{
+	if (m_reclaimer)
+		m_reclaimer->Flush();
 }
 }
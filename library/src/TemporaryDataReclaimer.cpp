@@ -0,0 +1,108 @@
+#include <TemporaryDataReclaimer.hpp>
+#include <new>
+#include <utility>
+
+namespace Callisto
+{
+TemporaryDataReclaimer::TemporaryDataReclaimer(size_t maxOutstandingBytes)
+	: m_head{ nullptr }, m_outstandingBytes{ 0u }, m_outstandingNodeCount{ 0u }, m_signal{ 0u },
+	m_maxOutstandingBytes{ maxOutstandingBytes },
+	m_worker{ [this](std::stop_token stopToken) { Run(stopToken); } }
+{}
+
+TemporaryDataReclaimer::~TemporaryDataReclaimer() noexcept
+{
+	m_worker.request_stop();
+	Signal();
+
+	// The worker destroys the remaining buckets before it stops.
+	if (m_worker.joinable())
+		m_worker.join();
+}
+
+void TemporaryDataReclaimer::Reclaim(TemporaryDataBucket&& bucket) noexcept
+{
+	if (bucket.IsEmpty())
+		return;
+
+	const size_t byteSize = bucket.GetHeldBytes();
+
+	Node* node            = nullptr;
+
+	if (m_outstandingBytes.fetch_add(byteSize, std::memory_order_relaxed) + byteSize
+		<= m_maxOutstandingBytes)
+		node = new (std::nothrow) Node{ std::move(bucket), byteSize, nullptr };
+
+	// Over the bound, so it is destroyed here, like without the reclaimer.
+	if (!node)
+	{
+		m_outstandingBytes.fetch_sub(byteSize, std::memory_order_relaxed);
+
+		TemporaryDataBucket expiredBucket{ std::move(bucket) };
+
+		return;
+	}
+
+	m_outstandingNodeCount.fetch_add(1u, std::memory_order_relaxed);
+
+	node->next = m_head.load(std::memory_order_relaxed);
+
+	// Release, so the bucket is visible to the worker.
+	while (!m_head.compare_exchange_weak(
+		node->next, node, std::memory_order_release, std::memory_order_relaxed
+	));
+
+	Signal();
+}
+
+void TemporaryDataReclaimer::Flush() noexcept
+{
+	for (size_t nodeCount = m_outstandingNodeCount.load(std::memory_order_acquire); nodeCount;
+		nodeCount = m_outstandingNodeCount.load(std::memory_order_acquire))
+		m_outstandingNodeCount.wait(nodeCount, std::memory_order_acquire);
+}
+
+void TemporaryDataReclaimer::Run(std::stop_token stopToken) noexcept
+{
+	while (true)
+	{
+		// The signal must be read before the stack. If a bucket is pushed after the stack was
+		// taken, the signal will have changed, so the wait won't block.
+		const std::uint32_t signal = m_signal.load(std::memory_order_acquire);
+
+		if (Node* nodes = m_head.exchange(nullptr, std::memory_order_acquire); nodes)
+			DestroyNodes(nodes);
+		else if (stopToken.stop_requested())
+			break;
+		else
+			m_signal.wait(signal, std::memory_order_acquire);
+	}
+}
+
+void TemporaryDataReclaimer::DestroyNodes(Node* nodes) noexcept
+{
+	size_t nodeCount = 0u;
+
+	while (nodes)
+	{
+		Node* next            = nodes->next;
+		const size_t byteSize = nodes->byteSize;
+
+		delete nodes;
+
+		m_outstandingBytes.fetch_sub(byteSize, std::memory_order_relaxed);
+
+		nodes = next;
+		++nodeCount;
+	}
+
+	m_outstandingNodeCount.fetch_sub(nodeCount, std::memory_order_release);
+	m_outstandingNodeCount.notify_all();
+}
+
+void TemporaryDataReclaimer::Signal() noexcept
+{
+	m_signal.fetch_add(1u, std::memory_order_release);
+	m_signal.notify_one();
+}
+}
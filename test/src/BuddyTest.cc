@@ -404,3 +404,70 @@ TEST(BuddyTest, DeallocationTest)
 		}
 	}
 }
+
+TEST(BuddyTest, DefragmentationTest)
+{
+	constexpr size_t totalSize        = 1_KB;
+	constexpr size_t minimumBlockSize = 64_B;
+	constexpr size_t alignment        = 64_B;
+
+	Callisto::Buddy buddy{ 0u, totalSize, minimumBlockSize };
+
+	std::vector<Callisto::Buddy::LiveAllocation> allocations{};
+
+	for (size_t index = 0u; index < 4u; ++index)
+		allocations.emplace_back(
+			Callisto::Buddy::LiveAllocation{
+				.startingAddress = buddy.Allocate(256_B, alignment),
+				.size            = 256_B,
+				.alignment       = alignment
+			}
+		);
+
+	EXPECT_EQ(buddy.AvailableSize(), 0u) << "AvailableSize isn't 0.";
+
+	// Free the first and the third blocks, so no 512B block can be allocated.
+	std::ranges::sort(allocations, {}, &Callisto::Buddy::LiveAllocation::startingAddress);
+
+	buddy.Deallocate(allocations[0].startingAddress, 256_B, alignment);
+	buddy.Deallocate(allocations[2].startingAddress, 256_B, alignment);
+
+	std::vector<Callisto::Buddy::LiveAllocation> liveAllocations{ allocations[1], allocations[3] };
+
+	EXPECT_EQ(buddy.AllocateN(512_B, alignment), std::nullopt) << "512B shouldn't be available.";
+
+	const std::vector<Callisto::DefragmentationMove> moves = buddy.Defragment(
+		liveAllocations, 1_KB
+	);
+
+	EXPECT_EQ(std::size(moves), 1u) << "Move count isn't 1.";
+	EXPECT_EQ(moves[0].srcOffset, 768_B) << "Move src isn't 768B.";
+	EXPECT_EQ(moves[0].size, 256_B) << "Move size isn't 256B.";
+	EXPECT_EQ(liveAllocations[1].startingAddress, moves[0].dstOffset)
+		<< "The live allocation wasn't updated.";
+	EXPECT_EQ(buddy.AvailableSize(), 512_B) << "AvailableSize isn't 512B.";
+	EXPECT_NE(buddy.AllocateN(512_B, alignment), std::nullopt) << "512B should be available.";
+}
+
+TEST(BuddyTest, AlignedSearchTest)
+{
+	constexpr size_t totalSize        = 512_B;
+	constexpr size_t minimumBlockSize = 64_B;
+
+	Callisto::Buddy buddy{ 0u, totalSize, minimumBlockSize };
+
+	for (size_t index = 0u; index < 8u; ++index)
+		[[maybe_unused]] const size_t address = buddy.Allocate(64_B, 64_B);
+
+	// None of their buddies are free, so they won't be merged. The blocks of the same size are
+	// kept in the order they were freed, so the only block which is aligned to 128B is the
+	// first one, followed by two misaligned ones. A binary search over the aligned sizes would
+	// skip the first block.
+	buddy.Deallocate(0_B, 64_B, 64_B);
+	buddy.Deallocate(192_B, 64_B, 64_B);
+	buddy.Deallocate(320_B, 64_B, 64_B);
+
+	EXPECT_EQ(buddy.AllocateN(64_B, 128_B), 0_B) << "The block aligned to 128B wasn't found.";
+	EXPECT_EQ(buddy.AllocateN(64_B, 128_B), std::nullopt) << "A misaligned block was used.";
+	EXPECT_EQ(buddy.AvailableSize(), 128_B) << "AvailableSize isn't 128B.";
+}
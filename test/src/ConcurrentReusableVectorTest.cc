@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <ConcurrentReusableVector.hpp>
+#include <ReusableVector.hpp>
+#include <CallistoException.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <limits>
+#include <iomanip>
+#include <iostream>
+
+TEST(ConcurrentReusableVectorTest, SegmentTest)
+{
+	Callisto::ConcurrentReusableVector<int, 64u> rVec{ 100u };
+
+	// The first two segments should have been allocated.
+	EXPECT_EQ(std::size(rVec), 192u) << "RVec size isn't 192.";
+
+	for (int value = 0; value < 192; ++value)
+		[[maybe_unused]] const size_t index = rVec.Add(value);
+
+	int* firstElement = &rVec[0];
+
+	const size_t index = rVec.Add(192);
+
+	EXPECT_EQ(index, 192u) << "Index isn't 192.";
+	EXPECT_EQ(std::size(rVec), 448u) << "RVec size isn't 448.";
+	EXPECT_EQ(firstElement, &rVec[0]) << "The first element was moved.";
+	EXPECT_EQ(rVec[191], 191) << "RVec index 191 isn't 191.";
+
+	rVec.RemoveElement(70u);
+
+	EXPECT_FALSE(rVec.IsInUse(70u)) << "RVec index 70 is in use.";
+	EXPECT_EQ(rVec.Add(500), 70u) << "Index 70 wasn't reused.";
+	EXPECT_EQ(rVec[70], 500) << "RVec index 70 isn't 500.";
+}
+
+TEST(ConcurrentReusableVectorTest, ConcurrentAddRemoveTest)
+{
+	constexpr size_t threadCount       = 8u;
+	constexpr size_t elementsPerThread = 5000u;
+
+	Callisto::ConcurrentReusableVector<size_t, 64u> rVec{};
+
+	std::vector<std::vector<size_t>> threadIndices(threadCount);
+
+	{
+		std::vector<std::jthread> threads{};
+
+		for (size_t threadIndex = 0u; threadIndex < threadCount; ++threadIndex)
+			threads.emplace_back(
+				[&rVec, &indices = threadIndices[threadIndex], threadIndex]
+				{
+					for (size_t elementIndex = 0u; elementIndex < elementsPerThread; ++elementIndex)
+					{
+						const size_t value = threadIndex * elementsPerThread + elementIndex;
+
+						indices.emplace_back(rVec.Add(value));
+
+						// Remove every other element, so the indices are reused.
+						if (elementIndex % 2u)
+						{
+							rVec.RemoveElement(indices.back());
+							indices.pop_back();
+						}
+					}
+				}
+			);
+	}
+
+	std::vector<size_t> allIndices{};
+
+	for (size_t threadIndex = 0u; threadIndex < threadCount; ++threadIndex)
+	{
+		const std::vector<size_t>& indices = threadIndices[threadIndex];
+
+		for (size_t elementIndex = 0u; elementIndex < std::size(indices); ++elementIndex)
+		{
+			const size_t index = indices[elementIndex];
+
+			EXPECT_TRUE(rVec.IsInUse(index)) << "Index " << index << " isn't in use.";
+			EXPECT_EQ(rVec[index], threadIndex * elementsPerThread + elementIndex * 2u)
+				<< "Index " << index << " was overwritten.";
+		}
+
+		allIndices.insert(std::end(allIndices), std::begin(indices), std::end(indices));
+	}
+
+	std::ranges::sort(allIndices);
+
+	EXPECT_EQ(std::ranges::adjacent_find(allIndices), std::end(allIndices))
+		<< "An index was claimed by two threads.";
+	EXPECT_EQ(std::size(allIndices), threadCount * elementsPerThread / 2u)
+		<< "Element count is wrong.";
+}
+
+TEST(ConcurrentReusableVectorTest, OverflowTest)
+{
+	Callisto::ConcurrentReusableVector<int, 64u> rVec{};
+
+	EXPECT_THROW(rVec.Resize(std::numeric_limits<size_t>::max()), Callisto::Exception)
+		<< "Resizing past every segment didn't throw.";
+	EXPECT_EQ(std::size(rVec), 0u) << "A segment was added.";
+}
+
+// Not a strict benchmark, as the timings aren't checked. It prints the throughput of adding and
+// removing with 1 to N threads, next to a ReusableVector behind a mutex, so the scaling can be
+// compared. It depends on the machine, so it is disabled and should be run with
+// --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST(ConcurrentReusableVectorTest, DISABLED_ContentionBenchmarkTest)
+{
+	constexpr size_t operationsPerThread = 100'000u;
+
+	const size_t maxThreadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1u, 16u);
+
+	auto runThreads = [](size_t threadCount, auto&& function)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+
+		{
+			std::vector<std::jthread> threads{};
+
+			for (size_t threadIndex = 0u; threadIndex < threadCount; ++threadIndex)
+				threads.emplace_back(function);
+		}
+
+		const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+		return static_cast<double>(threadCount * operationsPerThread) / duration.count();
+	};
+
+	for (size_t threadCount = 1u; threadCount <= maxThreadCount; threadCount *= 2u)
+	{
+		Callisto::ConcurrentReusableVector<size_t> rVec{};
+
+		const double concurrentThroughput = runThreads(
+			threadCount,
+			[&rVec]
+			{
+				for (size_t operationIndex = 0u; operationIndex < operationsPerThread; ++operationIndex)
+					rVec.RemoveElement(rVec.Add(operationIndex));
+			}
+		);
+
+		Callisto::ReusableVector<size_t> lockedVec{};
+		std::mutex vectorMutex{};
+
+		const double lockedThroughput = runThreads(
+			threadCount,
+			[&lockedVec, &vectorMutex]
+			{
+				for (size_t operationIndex = 0u; operationIndex < operationsPerThread; ++operationIndex)
+				{
+					std::scoped_lock vectorLock{ vectorMutex };
+
+					lockedVec.RemoveElement(lockedVec.Add(operationIndex));
+				}
+			}
+		);
+
+		std::cout << std::fixed << std::setprecision(0)
+			<< "[ BENCHMARK] " << std::setw(2) << threadCount << " threads: "
+			<< std::setw(12) << concurrentThroughput << " ops/s concurrent, "
+			<< std::setw(12) << lockedThroughput << " ops/s locked\n";
+
+		// Every element was removed, so there shouldn't be any index in use.
+		for (size_t index = 0u; index < std::size(rVec); ++index)
+			EXPECT_FALSE(rVec.IsInUse(index)) << "Index " << index << " is in use.";
+	}
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <IndicesManager.hpp>
+
+TEST(IndicesManagerTest, AvailabilityTest)
+{
+	Callisto::IndicesManager indicesManager{ 200u };
+
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 200u) << "Doesn't have 200 free indices.";
+	EXPECT_EQ(indicesManager.GetActiveIndexCount(), 0u) << "Doesn't have 0 active indices.";
+
+	for (size_t index = 0u; index < 150u; ++index)
+		indicesManager.ToggleAvailability(index, false);
+
+	// Toggling to the same availability shouldn't change the counts.
+	indicesManager.ToggleAvailability(149u, false);
+
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 50u) << "Doesn't have 50 free indices.";
+	EXPECT_EQ(indicesManager.GetActiveIndexCount(), 150u) << "Doesn't have 150 active indices.";
+	EXPECT_EQ(indicesManager.GetFirstAvailableIndex(), 150u) << "First available index isn't 150.";
+
+	indicesManager.ToggleAvailability(70u, true);
+
+	EXPECT_TRUE(indicesManager.IsInUse(69u)) << "Index 69 isn't in use.";
+	EXPECT_FALSE(indicesManager.IsInUse(70u)) << "Index 70 is in use.";
+	EXPECT_EQ(indicesManager.GetFirstAvailableIndex(), 70u) << "First available index isn't 70.";
+	EXPECT_EQ(indicesManager.GetNextAvailableIndex(70u), 150u) << "Next available index isn't 150.";
+	EXPECT_EQ(indicesManager.GetNextAvailableIndex(199u), std::nullopt)
+		<< "Found an index after the last one.";
+
+	std::vector<std::uint32_t> availableIndices = indicesManager.GetAllAvailableIndicesU32();
+
+	EXPECT_EQ(std::size(availableIndices), 51u) << "Available index count isn't 51.";
+	EXPECT_EQ(availableIndices[0], 70u) << "Available index 0 isn't 70.";
+	EXPECT_EQ(availableIndices[1], 150u) << "Available index 1 isn't 150.";
+	EXPECT_EQ(availableIndices[50], 199u) << "Available index 50 isn't 199.";
+}
+
+TEST(IndicesManagerTest, ResizeTest)
+{
+	Callisto::IndicesManager indicesManager{ 5000u };
+
+	for (size_t index = 0u; index < 5000u; ++index)
+		indicesManager.ToggleAvailability(index, false);
+
+	EXPECT_EQ(indicesManager.GetFirstAvailableIndex(), std::nullopt) << "Found an available index.";
+
+	indicesManager.Resize(5001u);
+
+	EXPECT_EQ(indicesManager.GetFirstAvailableIndex(), 5000u) << "First available index isn't 5000.";
+
+	indicesManager.ToggleAvailability(4500u, true);
+	indicesManager.Resize(4600u);
+
+	EXPECT_EQ(std::size(indicesManager), 4600u) << "Size isn't 4600.";
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 1u) << "Doesn't have 1 free index.";
+	EXPECT_EQ(indicesManager.GetNextAvailableIndex(4500u), std::nullopt)
+		<< "Found a removed index.";
+}
+
+TEST(IndicesManagerTest, EraseTest)
+{
+	Callisto::IndicesManager indicesManager{ 130u };
+
+	for (size_t index = 0u; index < 130u; ++index)
+		indicesManager.ToggleAvailability(index, index % 2u == 0u);
+
+	indicesManager.erase(1u);
+
+	EXPECT_EQ(std::size(indicesManager), 129u) << "Size isn't 129.";
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 65u) << "Doesn't have 65 free indices.";
+	EXPECT_FALSE(indicesManager.IsInUse(1u)) << "Index 1 is in use.";
+	EXPECT_TRUE(indicesManager.IsInUse(2u)) << "Index 2 isn't in use.";
+	// Index 64 was 65 before and 127 was 128.
+	EXPECT_TRUE(indicesManager.IsInUse(64u)) << "Index 64 isn't in use.";
+	EXPECT_FALSE(indicesManager.IsInUse(127u)) << "Index 127 is in use.";
+
+	indicesManager.erase(127u);
+
+	EXPECT_EQ(std::size(indicesManager), 128u) << "Size isn't 128.";
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 64u) << "Doesn't have 64 free indices.";
+	EXPECT_EQ(indicesManager.GetNextAvailableIndex(125u), std::nullopt)
+		<< "Found an erased index.";
+}
+
+TEST(IndicesManagerTest, RangeTest)
+{
+	Callisto::IndicesManager indicesManager{ 300u };
+
+	indicesManager.ToggleAvailability(0u, 300u, false);
+
+	// Make free ranges of 100, 10 and 70 indices.
+	indicesManager.FreeRange(10u, 100u);
+	indicesManager.FreeRange(150u, 10u);
+	indicesManager.FreeRange(200u, 70u);
+
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 180u) << "Doesn't have 180 free indices.";
+	EXPECT_EQ(indicesManager.GetTrailingAvailableCount(), 0u) << "Trailing count isn't 0.";
+
+	EXPECT_EQ(indicesManager.AllocateRange(8u), 10u) << "FirstFit range doesn't start at 10.";
+	EXPECT_EQ(indicesManager.AllocateRange(8u, Callisto::FitPolicy::BestFit), 150u)
+		<< "BestFit range doesn't start at 150.";
+	EXPECT_EQ(indicesManager.AllocateRange(65u, Callisto::FitPolicy::BestFit), 200u)
+		<< "BestFit range doesn't start at 200.";
+	EXPECT_EQ(indicesManager.AllocateRange(100u), std::nullopt) << "Found a range of 100.";
+
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 99u) << "Doesn't have 99 free indices.";
+	EXPECT_TRUE(indicesManager.IsInUse(17u)) << "Index 17 isn't in use.";
+	EXPECT_FALSE(indicesManager.IsInUse(18u)) << "Index 18 is in use.";
+
+	indicesManager.FreeRange(265u, 35u);
+
+	EXPECT_EQ(indicesManager.GetTrailingAvailableCount(), 35u) << "Trailing count isn't 35.";
+}
+
+TEST(IndicesManagerTest, BatchTest)
+{
+	Callisto::IndicesManager indicesManager{ 300u };
+
+	indicesManager.ToggleAvailability(0u, 300u, false);
+
+	const std::vector<std::uint32_t> indices{ 1u, 2u, 63u, 64u, 65u, 299u, 3u, 2u };
+
+	indicesManager.FreeIndices(indices);
+
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 7u) << "Doesn't have 7 free indices.";
+	EXPECT_FALSE(indicesManager.IsInUse(299u)) << "Index 299 is in use.";
+	EXPECT_FALSE(indicesManager.IsInUse(3u)) << "Index 3 is in use.";
+	EXPECT_TRUE(indicesManager.IsInUse(4u)) << "Index 4 isn't in use.";
+	EXPECT_EQ(indicesManager.GetNextAvailableIndex(65u), 299u) << "Next free index isn't 299.";
+
+	// Removes 2 to 101, so 1 and 102 should become next to each other.
+	indicesManager.ToggleAvailability(102u, true);
+	indicesManager.erase(2u, 100u);
+
+	EXPECT_EQ(std::size(indicesManager), 200u) << "Size isn't 200.";
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 3u) << "Doesn't have 3 free indices.";
+	EXPECT_FALSE(indicesManager.IsInUse(1u)) << "Index 1 is in use.";
+	EXPECT_FALSE(indicesManager.IsInUse(2u)) << "Index 2 is in use.";
+	EXPECT_FALSE(indicesManager.IsInUse(199u)) << "Index 199 is in use.";
+	EXPECT_EQ(indicesManager.GetNextAvailableIndex(2u), 199u) << "Next free index isn't 199.";
+
+	indicesManager.erase(150u, 50u);
+
+	EXPECT_EQ(std::size(indicesManager), 150u) << "Size isn't 150.";
+	EXPECT_EQ(indicesManager.GetFreeIndexCount(), 2u) << "Doesn't have 2 free indices.";
+	EXPECT_EQ(indicesManager.GetNextAvailableIndex(2u), std::nullopt) << "Found an erased index.";
+}
@@ -1,6 +1,21 @@
 #include <gtest/gtest.h>
 
 #include <ReusableVector.hpp>
+#include <AllocatorSTL.hpp>
+#include <string>
+#include <array>
+#include <numeric>
+#include <memory_resource>
+#include <version>
+#if __has_include(<execution>)
+#include <execution>
+#endif
+#include <atomic>
+#include <span>
+#include <ranges>
+#include <limits>
+#include <cstring>
+#include <cstddef>
 
 TEST(ReusableContainerTest, VectorTest)
 {
@@ -238,3 +253,575 @@ TEST(ReusableContainerTest, VecDefaultInitTest)
 	EXPECT_EQ(rVec.GetIndicesManager().GetFreeIndexCount(), 10u)
 		<< "Doesn't have 10 free indices.";
 }
+
+TEST(ReusableContainerTest, VectorAddRangeTest)
+{
+	Callisto::ReusableVector<int> rVec{};
+
+	const size_t firstIndex = rVec.AddRange(std::vector<int>{ 1, 2, 3, 4, 5 });
+
+	EXPECT_EQ(firstIndex, 0u) << "First index isn't 0.";
+
+	rVec.RemoveElement(1u);
+	rVec.RemoveRange(3u, 2u);
+
+	// The two free indices at the end should be used by the new range.
+	std::vector<int> itemsToAdd{ 6, 7, 8 };
+
+	const size_t firstIndex1 = rVec.AddRange(itemsToAdd);
+
+	EXPECT_EQ(firstIndex1, 3u) << "First index 1 isn't 3.";
+	EXPECT_EQ(std::size(rVec), 6u) << "RVec size isn't 6.";
+	EXPECT_EQ(rVec[3], 6) << "RVec index 3 isn't 6.";
+	EXPECT_EQ(rVec[5], 8) << "RVec index 5 isn't 8.";
+	EXPECT_EQ(rVec[4], 7) << "RVec index 4 isn't 7.";
+	EXPECT_FALSE(rVec.IsInUse(1u)) << "RVec index 1 is in use.";
+
+	const size_t firstIndex2 = rVec.AddRange(std::vector<int>{ 9 });
+
+	EXPECT_EQ(firstIndex2, 1u) << "First index 2 isn't 1.";
+
+	rVec.RemoveElement(5u);
+
+	// An empty range shouldn't take or remove any index.
+	const size_t firstIndex3 = rVec.AddRange(std::vector<int>{});
+
+	EXPECT_EQ(firstIndex3, 6u) << "First index 3 isn't 6.";
+	EXPECT_EQ(std::size(rVec), 6u) << "RVec size isn't 6.";
+	EXPECT_FALSE(rVec.IsInUse(5u)) << "RVec index 5 is in use.";
+	EXPECT_EQ(rVec.GetIndicesManager().GetFreeIndexCount(), 1u) << "Free index count isn't 1.";
+}
+
+TEST(ReusableContainerTest, VectorForEachActiveTest)
+{
+	Callisto::ReusableVector<int> rVec{};
+
+	for (int value = 0; value < 200; ++value)
+		[[maybe_unused]] size_t index = rVec.Add(value);
+
+	for (size_t index = 0u; index < 200u; ++index)
+		if (index % 3u == 0u || (index >= 60u && index < 130u))
+			rVec.RemoveElement(index);
+
+	size_t activeCount = 0u;
+	int activeSum      = 0;
+
+	rVec.ForEachActive(
+		[&activeCount, &activeSum](size_t index, int& element)
+		{
+			EXPECT_EQ(static_cast<size_t>(element), index) << "Element isn't at its index.";
+
+			++activeCount;
+			activeSum += element;
+		}
+	);
+
+	int expectedSum = 0;
+
+	for (size_t index : rVec.GetActiveIndices())
+		expectedSum += rVec[index];
+
+	EXPECT_EQ(activeCount, rVec.GetIndicesManager().GetActiveIndexCount())
+		<< "Didn't visit every active element.";
+	EXPECT_EQ(activeSum, expectedSum) << "The active indices didn't visit the same elements.";
+
+	size_t chunkCount = 0u;
+	activeCount       = 0u;
+
+	std::as_const(rVec).ForEachActiveChunk(
+		[&chunkCount, &activeCount](size_t firstIndex, std::span<const int> elements)
+		{
+			EXPECT_EQ(elements[0], static_cast<int>(firstIndex)) << "Chunk doesn't match its index.";
+
+			++chunkCount;
+			activeCount += std::size(elements);
+		}
+	);
+
+	EXPECT_EQ(activeCount, rVec.GetIndicesManager().GetActiveIndexCount())
+		<< "The chunks didn't have every active element.";
+	// Two chunks of two elements in every three elements, but 60 to 130 are removed.
+	EXPECT_EQ(chunkCount, 44u) << "Chunk count isn't 44.";
+}
+
+TEST(ReusableContainerTest, VectorCompactTest)
+{
+	Callisto::ReusableVector<int> rVec{};
+
+	[[maybe_unused]] std::vector<std::uint32_t> itemIndices = rVec.AddElementsU32(
+		std::vector<int>{ 0, 1, 2, 3, 4, 5, 6 }
+	);
+
+	rVec.RemoveElement(1u);
+	rVec.RemoveElement(2u);
+	rVec.RemoveElement(5u);
+
+	const std::vector<std::uint32_t> remapTable = rVec.Compact();
+
+	constexpr std::uint32_t removedIndex = std::numeric_limits<std::uint32_t>::max();
+
+	const std::vector<std::uint32_t> expectedTable{
+		0u, removedIndex, removedIndex, 1u, 2u, removedIndex, 3u
+	};
+
+	EXPECT_EQ(remapTable, expectedTable) << "The remap table is wrong.";
+	EXPECT_EQ(std::size(rVec), 4u) << "RVec size isn't 4.";
+	EXPECT_EQ(rVec.GetIndicesManager().GetFreeIndexCount(), 0u) << "RVec has free indices.";
+
+	for (size_t oldIndex = 0u; oldIndex < std::size(remapTable); ++oldIndex)
+	{
+		if (remapTable[oldIndex] != removedIndex)
+		{
+			EXPECT_EQ(rVec[remapTable[oldIndex]], static_cast<int>(oldIndex))
+				<< "Element " << oldIndex << " wasn't moved to its new index.";
+		}
+	}
+
+	rVec.RemoveElement(0u);
+
+	size_t moveCount = 0u;
+
+	rVec.Compact([&moveCount](size_t, size_t) { ++moveCount; });
+
+	EXPECT_EQ(moveCount, 3u) << "Move count isn't 3.";
+	EXPECT_EQ(rVec[0], 3) << "RVec index 0 isn't 3.";
+}
+
+TEST(ReusableContainerTest, VectorAddElementsOutputTest)
+{
+	Callisto::ReusableVector<std::string> rVec{ 4u };
+
+	[[maybe_unused]] const size_t testIndex = rVec.Add(std::string{ "a" });
+
+	std::array<std::uint32_t, 5u> indices{};
+
+	std::vector<std::string> itemsToAdd{ "b", "c", "d", "e", "f" };
+
+	auto indicesEnd = rVec.AddElementsU32(std::move(itemsToAdd), std::begin(indices));
+
+	EXPECT_EQ(indicesEnd, std::end(indices)) << "Didn't write 5 indices.";
+	EXPECT_EQ(std::size(rVec), 6u) << "RVec size isn't 6.";
+	EXPECT_TRUE(std::empty(itemsToAdd[0])) << "The elements weren't moved.";
+
+	for (size_t index = 0u; index < std::size(indices); ++index)
+		EXPECT_EQ(indices[index], index + 1u) << "Index " << index << " isn't " << index + 1u;
+
+	EXPECT_EQ(rVec[5], "f") << "RVec index 5 isn't f.";
+
+	rVec.RemoveElement(2u);
+	rVec.RemoveElement(4u);
+
+	// Add fewer elements than the free indices and from a range without a size.
+	std::vector<std::uint32_t> indices1{};
+	const std::string lastItem = "g";
+
+	rVec.AddElementsU32(
+		std::views::single(lastItem) | std::views::filter([](const std::string&) { return true; }),
+		std::back_inserter(indices1)
+	);
+
+	EXPECT_EQ(indices1, std::vector<std::uint32_t>{ 2u }) << "The new index isn't 2.";
+	EXPECT_EQ(lastItem, "g") << "The element of an lvalue range was moved.";
+	EXPECT_TRUE(rVec.IsInUse(2u)) << "RVec index 2 isn't in use.";
+	EXPECT_FALSE(rVec.IsInUse(4u)) << "RVec index 4 is in use.";
+
+	std::vector<std::uint32_t> freeIndices(3u);
+
+	rVec.GetFreeIndicesU32(3u, std::begin(freeIndices));
+
+	EXPECT_EQ(freeIndices, (std::vector<std::uint32_t>{ 4u, 6u, 7u })) << "Free indices are wrong.";
+}
+
+TEST(ReusableContainerTest, VectorAddElementsBorrowedTest)
+{
+	Callisto::ReusableVector<std::string> rVec{};
+
+	std::vector<std::string> itemsToAdd{
+		"A string which is too long for SSO.", "Another string which is too long for SSO."
+	};
+
+	std::vector<std::uint32_t> indices{};
+
+	// Rvalue views, which still refer to the caller's elements.
+	rVec.AddElementsU32(std::span{ itemsToAdd }, std::back_inserter(indices));
+	rVec.AddElementsU32(itemsToAdd | std::views::take(1u), std::back_inserter(indices));
+
+	EXPECT_EQ(indices, (std::vector<std::uint32_t>{ 0u, 1u, 2u })) << "The indices are wrong.";
+	EXPECT_EQ(itemsToAdd[0], "A string which is too long for SSO.")
+		<< "The first element of the span was moved.";
+	EXPECT_EQ(itemsToAdd[1], "Another string which is too long for SSO.")
+		<< "The second element of the span was moved.";
+	EXPECT_EQ(rVec[2], itemsToAdd[0]) << "RVec index 2 isn't the first element.";
+}
+
+TEST(ReusableContainerTest, PagedVectorTest)
+{
+	static_assert(std::random_access_iterator<Callisto::PagedVector<int>::iterator>);
+	static_assert(std::random_access_iterator<Callisto::PagedVector<int>::const_iterator>);
+
+	Callisto::ReusablePagedVector<int, 4u> rPaged{};
+
+	const size_t testIndex = rPaged.Add(55);
+
+	int* firstElement = &rPaged[testIndex];
+
+	std::vector<std::uint32_t> itemIndices0 = rPaged.AddElementsU32(
+		std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }
+	);
+
+	EXPECT_EQ(std::size(rPaged), 11u) << "RPaged size isn't 11.";
+	EXPECT_EQ(firstElement, &rPaged[testIndex]) << "The first element was moved.";
+	EXPECT_EQ(&rPaged[2] + 1, &rPaged[3]) << "The elements of a page aren't contiguous.";
+	EXPECT_EQ(rPaged[10], 10) << "RPaged index 10 isn't 10.";
+
+	for (size_t index = 1u; index < 5u; ++index)
+		rPaged.RemoveElement(index);
+
+	rPaged.EraseInactiveElements();
+
+	EXPECT_EQ(std::size(rPaged), 7u) << "RPaged size isn't 7.";
+	EXPECT_EQ(rPaged[0], 55) << "RPaged index 0 isn't 55.";
+	EXPECT_EQ(rPaged[1], 5) << "RPaged index 1 isn't 5.";
+	EXPECT_EQ(std::accumulate(std::begin(rPaged), std::end(rPaged), 0), 100)
+		<< "The elements don't add up to 100.";
+
+	rPaged.erase(0u);
+
+	EXPECT_EQ(rPaged[0], 5) << "RPaged index 0 isn't 5.";
+
+	// Across a page boundary.
+	rPaged.erase(2u, 3u);
+
+	EXPECT_EQ(std::size(rPaged), 3u) << "RPaged size isn't 3.";
+	EXPECT_EQ(rPaged[0], 5) << "RPaged index 0 isn't 5.";
+	EXPECT_EQ(rPaged[1], 6) << "RPaged index 1 isn't 6.";
+	EXPECT_EQ(rPaged[2], 10) << "RPaged index 2 isn't 10.";
+	EXPECT_TRUE(rPaged.IsInUse(2u)) << "RPaged index 2 isn't in use.";
+
+	rPaged.erase(0u, 2u);
+
+	EXPECT_EQ(std::size(rPaged), 1u) << "RPaged size isn't 1.";
+	EXPECT_EQ(rPaged[0], 10) << "RPaged index 0 isn't 10.";
+
+	// The removed elements should be default constructed when growing again.
+	rPaged.Resize(8u);
+
+	EXPECT_EQ(rPaged[1], 0) << "RPaged index 1 isn't 0.";
+	EXPECT_EQ(rPaged[7], 0) << "RPaged index 7 isn't 0.";
+}
+
+TEST(ReusableContainerTest, VectorDirtyTrackingTest)
+{
+	Callisto::ReusableVector<int> rVec{ 4u };
+
+	// Nothing should be tracked before enabling it.
+	rVec.Add(1);
+
+	rVec.EnableDirtyTracking(true);
+
+	{
+		std::vector<Callisto::DirtyRange> dirtyRanges = rVec.ConsumeDirtyRanges();
+
+		ASSERT_EQ(std::size(dirtyRanges), 1u) << "Dirty range count isn't 1.";
+		EXPECT_EQ(dirtyRanges[0].begin, 0u) << "The first dirty range doesn't begin at 0.";
+		EXPECT_EQ(dirtyRanges[0].end, 4u) << "The first dirty range doesn't end at 4.";
+		EXPECT_TRUE(std::empty(rVec.ConsumeDirtyRanges())) << "The dirty ranges weren't cleared.";
+	}
+
+	rVec.Add(2);
+	rVec.Add(3);
+	rVec.Modify(0u) = 5;
+
+	std::vector<std::uint32_t> itemIndices = rVec.AddElementsU32(std::vector<int>(70u, 7));
+
+	rVec.RemoveElement(66u);
+
+	{
+		std::vector<Callisto::DirtyRange> dirtyRanges = rVec.ConsumeDirtyRanges();
+
+		ASSERT_EQ(std::size(dirtyRanges), 1u) << "Dirty range count isn't 1.";
+		EXPECT_EQ(dirtyRanges[0].begin, 0u) << "The first dirty range doesn't begin at 0.";
+		EXPECT_EQ(dirtyRanges[0].end, 73u) << "The first dirty range doesn't end at 73.";
+	}
+
+	rVec.Modify(10u) = 1;
+	rVec.Modify(11u) = 1;
+	rVec.RemoveRange(64u, 2u);
+
+	{
+		std::vector<Callisto::DirtyRange> dirtyRanges = rVec.ConsumeDirtyRanges();
+
+		ASSERT_EQ(std::size(dirtyRanges), 2u) << "Dirty range count isn't 2.";
+		EXPECT_EQ(dirtyRanges[0].begin, 10u) << "The first dirty range doesn't begin at 10.";
+		EXPECT_EQ(dirtyRanges[0].end, 12u) << "The first dirty range doesn't end at 12.";
+		EXPECT_EQ(dirtyRanges[1].begin, 64u) << "The second dirty range doesn't begin at 64.";
+		EXPECT_EQ(dirtyRanges[1].end, 66u) << "The second dirty range doesn't end at 66.";
+	}
+
+	rVec.EnableDirtyTracking(false);
+	rVec.Modify(1u) = 1;
+
+	EXPECT_TRUE(std::empty(rVec.ConsumeDirtyRanges())) << "Disabled tracking has dirty ranges.";
+}
+
+TEST(ReusableContainerTest, VectorAllocatorTest)
+{
+	constexpr size_t memorySize = 4096u;
+	alignas(64u) std::uint8_t memory[memorySize];
+	Callisto::Allocator allocator{ memory, std::size(memory), 64_B };
+
+	{
+		using IntAllocator_t = Callisto::AllocatorSTL<int>;
+
+		Callisto::ReusableContainer<int, std::vector<int, IntAllocator_t>> rVec{
+			8u, IntAllocator_t{ allocator }
+		};
+
+		EXPECT_LT(allocator.GetAvailableSize(), memorySize)
+			<< "The elements weren't allocated from the allocator.";
+
+		const size_t availableSize = allocator.GetAvailableSize();
+
+		auto itemIndices = rVec.AddElementsU32(std::vector<int>{ 1, 2, 3 });
+
+		EXPECT_LT(allocator.GetAvailableSize(), availableSize)
+			<< "The indices weren't allocated from the allocator.";
+		EXPECT_EQ(itemIndices[2], 2u) << "Item index 2 isn't 2.";
+		EXPECT_EQ(rVec[2], 3) << "RVec index 2 isn't 3.";
+	}
+
+	EXPECT_EQ(allocator.GetAvailableSize(), memorySize) << "Not everything was deallocated.";
+
+	std::array<std::byte, 2048u> buffer{};
+	std::pmr::monotonic_buffer_resource resource{
+		std::data(buffer), std::size(buffer), std::pmr::null_memory_resource()
+	};
+
+	Callisto::pmr::ReusableVector<int> rPmrVec{ &resource };
+
+	rPmrVec.Add(1);
+	rPmrVec.Add(2);
+
+	EXPECT_EQ(rPmrVec.Get().get_allocator().resource(), &resource)
+		<< "The elements don't use the memory resource.";
+	EXPECT_EQ(rPmrVec.GetIndicesManager().get_allocator().resource(), &resource)
+		<< "The indices manager doesn't use the memory resource.";
+	EXPECT_EQ(rPmrVec.GetFreeIndicesU32(1u).get_allocator().resource(), &resource)
+		<< "The free indices don't use the memory resource.";
+}
+
+TEST(ReusableContainerTest, VectorTrimTest)
+{
+	Callisto::ReusableVector<int> rVec{};
+
+	for (int value = 0; value < 100; ++value)
+		rVec.Add(value);
+
+	EXPECT_EQ(rVec.TrimTrailingFreeSlots(), 0u) << "Trimmed slots which are in use.";
+
+	rVec.SetTrimPolicy(
+		Callisto::TrimPolicy{ .freeFractionThreshold = 0.5f, .headroomFraction = 0.25f }
+	);
+
+	// Removing half of the elements shouldn't trim yet.
+	for (size_t index = 99u; index >= 50u; --index)
+		rVec.RemoveElement(index);
+
+	EXPECT_EQ(std::size(rVec), 100u) << "RVec size isn't 100.";
+
+	// 51 free slots of 100, so it should be trimmed to the 49 elements and 12 free slots.
+	rVec.RemoveElement(49u);
+
+	EXPECT_EQ(std::size(rVec), 61u) << "RVec size isn't 61.";
+	EXPECT_EQ(rVec.GetIndicesManager().GetFreeIndexCount(), 12u) << "Free index count isn't 12.";
+
+	// The next additions should use the headroom instead of growing.
+	for (int value = 0; value < 12; ++value)
+		rVec.Add(value);
+
+	EXPECT_EQ(std::size(rVec), 61u) << "RVec size isn't 61.";
+
+	rVec.SetTrimPolicy({});
+
+	for (size_t index = 60u; index >= 10u; --index)
+		rVec.RemoveElement(index);
+
+	EXPECT_EQ(std::size(rVec), 61u) << "Disabled policy trimmed the slots.";
+
+	EXPECT_EQ(rVec.TrimTrailingFreeSlots(5u), 46u) << "Trimmed slot count isn't 46.";
+	EXPECT_EQ(std::size(rVec), 15u) << "RVec size isn't 15.";
+
+	rVec.shrink_to_fit();
+
+	EXPECT_EQ(rVec.Get().capacity(), 15u) << "RVec capacity isn't 15.";
+	EXPECT_EQ(rVec[9], 9) << "RVec index 9 isn't 9.";
+}
+
+TEST(ReusableContainerTest, VectorSerializeTest)
+{
+	struct Vertex
+	{
+		float x;
+		float y;
+		std::uint16_t id;
+	};
+
+	Callisto::ReusableVector<Vertex> rVec{};
+
+	for (std::uint16_t index = 0u; index < 100u; ++index)
+		rVec.Add(Vertex{ .x = index * 1.5f, .y = index * 2.5f, .id = index });
+
+	rVec.RemoveElement(3u);
+	rVec.RemoveElement(70u);
+
+	std::vector<std::byte> image = rVec.Serialize();
+
+	EXPECT_EQ(std::size(image), rVec.GetSerializedSize()) << "The image size doesn't match.";
+
+	Callisto::ReusableVector<Vertex> rVec1{};
+
+	rVec1.Deserialize(image);
+
+	EXPECT_EQ(std::size(rVec1), 100u) << "RVec1 size isn't 100.";
+	EXPECT_EQ(rVec1[99].id, 99u) << "RVec1 index 99's id isn't 99.";
+	EXPECT_EQ(rVec1[50].y, 125.f) << "RVec1 index 50's y isn't 125.";
+	EXPECT_FALSE(rVec1.IsInUse(3u)) << "Index 3 is in use.";
+	EXPECT_FALSE(rVec1.IsInUse(70u)) << "Index 70 is in use.";
+	EXPECT_TRUE(rVec1.IsInUse(71u)) << "Index 71 isn't in use.";
+	EXPECT_EQ(rVec1.GetIndicesManager().GetFreeIndexCount(), 2u) << "Free index count isn't 2.";
+	EXPECT_EQ(rVec1.Add(Vertex{}), 3u) << "The first free index isn't 3.";
+
+	// An image with a different element size shouldn't be loaded.
+	Callisto::ReusableVector<std::uint64_t> rVec2{};
+
+	EXPECT_THROW(rVec2.Deserialize(image), Callisto::Exception) << "Wrong element size loaded.";
+
+	image[0] = std::byte{ 0u };
+
+	EXPECT_THROW(rVec1.Deserialize(image), Callisto::Exception) << "Wrong magic loaded.";
+	EXPECT_THROW(
+		rVec1.Deserialize(std::span<const std::byte>{ std::data(image), 8u }), Callisto::Exception
+	) << "Too small image loaded.";
+}
+
+TEST(ReusableContainerTest, VectorDeserializeCorruptTest)
+{
+	Callisto::ReusableVector<std::uint64_t> rVec{};
+
+	for (std::uint64_t value = 0u; value < 10u; ++value)
+		rVec.Add(value);
+
+	const std::vector<std::byte> image = rVec.Serialize();
+
+	Callisto::ReusableVector<std::uint64_t> rVec1{ 5u };
+
+	// The image is cut in the middle of the availability words.
+	EXPECT_THROW(
+		rVec1.Deserialize(std::span<const std::byte>{ std::data(image), std::size(image) - 1u }),
+		Callisto::Exception
+	) << "Truncated image loaded.";
+
+	constexpr size_t countOffset = offsetof(Callisto::ReusableContainerImageHeader, elementCount);
+
+	// A count which would overflow the size of the elements.
+	for (const std::uint64_t elementCount : {
+		std::numeric_limits<std::uint64_t>::max(), (std::uint64_t{ 1u } << 61u) + 1u,
+		std::uint64_t{ 11u }
+	}) {
+		std::vector<std::byte> corruptImage = image;
+
+		std::memcpy(std::data(corruptImage) + countOffset, &elementCount, sizeof(elementCount));
+
+		EXPECT_THROW(rVec1.Deserialize(corruptImage), Callisto::Exception)
+			<< "Image with " << elementCount << " elements loaded.";
+	}
+
+	EXPECT_EQ(std::size(rVec1), 5u) << "RVec1 was changed by a corrupt image.";
+
+	rVec1.Deserialize(image);
+
+	EXPECT_EQ(std::size(rVec1), 10u) << "RVec1 size isn't 10.";
+	EXPECT_EQ(rVec1[9], 9u) << "RVec1 index 9 isn't 9.";
+}
+
+TEST(ReusableContainerTest, VectorRemoveElementsTest)
+{
+	Callisto::ReusableVector<std::string> rVec{};
+
+	for (size_t index = 0u; index < 150u; ++index)
+		rVec.Add(std::to_string(index));
+
+	const std::array<std::uint32_t, 5u> removedIndices{ 3u, 4u, 70u, 71u, 149u };
+
+	rVec.RemoveElements(removedIndices);
+
+	EXPECT_EQ(rVec.GetIndicesManager().GetFreeIndexCount(), 5u) << "Free index count isn't 5.";
+	EXPECT_TRUE(std::empty(rVec[70])) << "RVec index 70 wasn't reset.";
+	EXPECT_FALSE(rVec.IsInUse(149u)) << "RVec index 149 is in use.";
+	EXPECT_EQ(rVec[72], "72") << "RVec index 72 isn't 72.";
+
+	rVec.erase(2u, 68u);
+
+	EXPECT_EQ(std::size(rVec), 82u) << "RVec size isn't 82.";
+	EXPECT_EQ(rVec[1], "1") << "RVec index 1 isn't 1.";
+	EXPECT_EQ(rVec[4], "72") << "RVec index 4 isn't 72.";
+	EXPECT_FALSE(rVec.IsInUse(2u)) << "RVec index 2 is in use.";
+	EXPECT_TRUE(rVec.IsInUse(4u)) << "RVec index 4 isn't in use.";
+	EXPECT_EQ(rVec.GetIndicesManager().GetFreeIndexCount(), 3u) << "Free index count isn't 3.";
+}
+
+#ifdef __cpp_lib_execution
+TEST(ReusableContainerTest, VectorParallelForEachActiveTest)
+{
+	Callisto::ReusableVector<size_t> rVec{};
+
+	for (size_t index = 0u; index < 5000u; ++index)
+		rVec.Add(index);
+
+	for (size_t index = 0u; index < 5000u; index += 3u)
+		rVec.RemoveElement(index);
+
+	const size_t activeCount = rVec.GetIndicesManager().GetActiveIndexCount();
+
+	// Every chunk should start at a word, and have about the same number of active elements.
+	const auto wordRanges = rVec.GetIndicesManager().SplitInUseWords(8u);
+
+	EXPECT_EQ(std::size(wordRanges), 8u) << "Chunk count isn't 8.";
+	EXPECT_EQ(wordRanges.front().firstWordIndex, 0u) << "The first chunk doesn't start at 0.";
+	EXPECT_EQ(wordRanges.back().endWordIndex, 79u) << "The last chunk doesn't end at 79.";
+
+	std::vector<std::atomic<std::uint32_t>> visitCounts(5000u);
+
+	rVec.ParallelForEachActive(
+		std::execution::par, [&visitCounts](size_t index, size_t& element)
+		{
+			visitCounts[index].fetch_add(1u);
+			element *= 2u;
+		}, 8u
+	);
+
+	std::atomic<size_t> sum{ 0u };
+
+	std::as_const(rVec).ParallelForEachActive(
+		std::execution::seq, [&sum](const size_t& element) { sum.fetch_add(element); }
+	);
+
+	size_t expectedSum  = 0u;
+	size_t visitedCount = 0u;
+
+	for (size_t index = 0u; index < 5000u; ++index)
+	{
+		EXPECT_EQ(visitCounts[index].load(), rVec.IsInUse(index) ? 1u : 0u)
+			<< "Index " << index << " wasn't visited once.";
+
+		if (rVec.IsInUse(index))
+		{
+			expectedSum += index * 2u;
+			++visitedCount;
+		}
+	}
+
+	EXPECT_EQ(visitedCount, activeCount) << "Visited count isn't the active count.";
+	EXPECT_EQ(sum.load(), expectedSum) << "The active elements weren't doubled.";
+}
+#endif
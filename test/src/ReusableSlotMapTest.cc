@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <ReusableSlotMap.hpp>
+#include <CallistoException.hpp>
+#include <numeric>
+#include <cstdint>
+
+TEST(ReusableSlotMapTest, AddRemoveTest)
+{
+	Callisto::ReusableSlotMap<int> slotMap{};
+
+	const auto handle  = slotMap.Add(1);
+	const auto handle1 = slotMap.Add(2);
+	const auto handle2 = slotMap.Add(3);
+
+	EXPECT_EQ(std::size(slotMap), 3u) << "SlotMap size isn't 3.";
+	EXPECT_EQ(slotMap[handle1], 2) << "Handle 1's element isn't 2.";
+
+	slotMap.Remove(handle);
+
+	// The last element should have been moved to the front.
+	EXPECT_EQ(std::size(slotMap), 2u) << "SlotMap size isn't 2.";
+	EXPECT_EQ(*std::begin(slotMap), 3) << "The first element isn't 3.";
+	EXPECT_EQ(slotMap[handle2], 3) << "Handle 2's element isn't 3.";
+	EXPECT_EQ(slotMap.GetHandle(0u), handle2) << "The first element's handle isn't handle 2.";
+	EXPECT_EQ(std::accumulate(std::begin(slotMap), std::end(slotMap), 0), 5)
+		<< "The live elements don't add up to 5.";
+
+	EXPECT_FALSE(slotMap.IsValid(handle)) << "Removed handle is valid.";
+	EXPECT_EQ(slotMap.Get(handle), nullptr) << "Removed handle has an element.";
+
+	// The slot of the removed element should be reused, but with a new generation.
+	const auto handle3 = slotMap.Add(4);
+
+	EXPECT_EQ(Callisto::ReusableSlotMap<int>::GetSlotIndex(handle3), 0u) << "Slot 0 wasn't reused.";
+	EXPECT_NE(handle3, handle) << "The stale handle aliases the new one.";
+	EXPECT_FALSE(slotMap.IsValid(handle)) << "Stale handle is valid.";
+	EXPECT_EQ(*slotMap.Get(handle3), 4) << "Handle 3's element isn't 4.";
+
+	slotMap.Remove(handle);
+
+	EXPECT_EQ(std::size(slotMap), 3u) << "Removing a stale handle removed an element.";
+}
+
+TEST(ReusableSlotMapTest, GenerationTest)
+{
+	using SlotMap_t = Callisto::ReusableSlotMap<int>;
+
+	SlotMap_t slotMap{};
+
+	const auto firstHandle = slotMap.Add(0);
+
+	slotMap.Remove(firstHandle);
+
+	// Use up every generation of slot 0.
+	for (std::uint32_t generation = 1u; generation <= SlotMap_t::s_generationMask; ++generation)
+	{
+		const auto handle = slotMap.Add(static_cast<int>(generation));
+
+		EXPECT_EQ(SlotMap_t::GetSlotIndex(handle), 0u) << "Slot 0 wasn't reused.";
+
+		slotMap.Remove(handle);
+	}
+
+	// Slot 0 should be retired instead of going back to generation 0.
+	const auto handle = slotMap.Add(1);
+
+	EXPECT_EQ(SlotMap_t::GetSlotIndex(handle), 1u) << "The retired slot was reused.";
+	EXPECT_FALSE(slotMap.IsValid(firstHandle)) << "A stale handle is valid.";
+	EXPECT_EQ(slotMap.Get(firstHandle), nullptr) << "A stale handle has an element.";
+
+	// The retired slot shouldn't be handed out again, even after the other slots are freed.
+	slotMap.Remove(handle);
+
+	for (int value = 0; value < 100; ++value)
+	{
+		const auto newHandle = slotMap.Add(value);
+
+		EXPECT_NE(SlotMap_t::GetSlotIndex(newHandle), 0u) << "The retired slot was handed out.";
+
+		if (value % 2)
+			slotMap.Remove(newHandle);
+	}
+
+	EXPECT_EQ(std::size(slotMap), 50u) << "Slot map size isn't 50.";
+}
+
+TEST(ReusableSlotMapTest, SlotIndexOverflowTest)
+{
+	using SlotMap_t = Callisto::ReusableSlotMap<std::uint8_t>;
+
+	SlotMap_t slotMap{};
+
+	for (size_t index = 0u; index <= SlotMap_t::s_slotIndexMask; ++index)
+		slotMap.Add(std::uint8_t{ 0u });
+
+	EXPECT_THROW(slotMap.Add(std::uint8_t{ 0u }), Callisto::Exception)
+		<< "Adding past the last slot index didn't throw.";
+	EXPECT_EQ(std::size(slotMap), SlotMap_t::s_slotIndexMask + 1u) << "An element was added.";
+}
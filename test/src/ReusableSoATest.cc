@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include <ReusableSoA.hpp>
+#include <string>
+#include <numeric>
+
+TEST(ReusableSoATest, AddRemoveTest)
+{
+	Callisto::ReusableSoA<int, float, std::string> soa{};
+
+	const size_t index  = soa.Add(1, 1.5f, std::string{ "One" });
+	const size_t index1 = soa.Add(2, 2.5f, std::string{ "Two" });
+	const size_t index2 = soa.Add(3, 3.5f, std::string{ "Three" });
+
+	EXPECT_EQ(std::size(soa), 3u) << "SoA size isn't 3.";
+	EXPECT_EQ(soa.Get<0>(index1), 2) << "Index 1's first component isn't 2.";
+	EXPECT_EQ(soa.Get<1>(index1), 2.5f) << "Index 1's second component isn't 2.5.";
+	EXPECT_EQ(soa.Get<2>(index2), "Three") << "Index 2's third component isn't Three.";
+
+	soa.RemoveElement(index);
+
+	EXPECT_FALSE(soa.IsInUse(index)) << "Removed index is in use.";
+	EXPECT_EQ(soa.Get<0>(index), 0) << "Removed first component wasn't reset.";
+	EXPECT_TRUE(std::empty(soa.Get<2>(index))) << "Removed third component wasn't reset.";
+
+	// Every column should reuse the same index.
+	const size_t index3 = soa.Add(4, 4.5f, std::string{ "Four" });
+
+	EXPECT_EQ(index3, index) << "The removed index wasn't reused.";
+	EXPECT_EQ(std::size(soa), 3u) << "SoA size isn't 3.";
+
+	std::span<int> intColumn = soa.Column<0>();
+
+	EXPECT_EQ(std::size(intColumn), 3u) << "Int column size isn't 3.";
+	EXPECT_EQ(std::accumulate(std::begin(intColumn), std::end(intColumn), 0), 9)
+		<< "The int column doesn't add up to 9.";
+
+	soa.Extend(5u);
+
+	EXPECT_EQ(std::size(soa.Column<1>()), 8u) << "Float column size isn't 8.";
+	EXPECT_EQ(std::size(soa.Column<2>()), 8u) << "String column size isn't 8.";
+	EXPECT_EQ(soa.GetIndicesManager().GetFreeIndexCount(), 5u) << "Free index count isn't 5.";
+}
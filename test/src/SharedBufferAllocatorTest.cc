@@ -119,3 +119,139 @@ TEST(SharedBufferAllocatorTest, ReallocationTest)
 	EXPECT_EQ(availableMemory[1].offset, 15_KB) << "Available block 1 offset isn't 15KB.";
 	EXPECT_EQ(availableMemory[1].size, 35_KB) << "Available block 1 size isn't 35KB.";
 }
+
+TEST(SharedBufferAllocatorTest, DefragmentationTest)
+{
+	Callisto::SharedBufferAllocator allocator{};
+
+	size_t bufferSize = 0u;
+
+	const auto allocation  = GetAllocation(allocator, bufferSize, 5_KB);
+	const auto allocation1 = GetAllocation(allocator, bufferSize, 15_KB);
+	const auto allocation2 = GetAllocation(allocator, bufferSize, 10_KB);
+	const auto allocation3 = GetAllocation(allocator, bufferSize, 10_KB);
+	const auto allocation4 = GetAllocation(allocator, bufferSize, 20_KB);
+	const auto allocation5 = GetAllocation(allocator, bufferSize, 10_KB);
+
+	EXPECT_EQ(allocation1.offset, 5_KB) << "Allocation 1 offset isn't 5KB.";
+	EXPECT_EQ(allocation3.offset, 30_KB) << "Allocation 3 offset isn't 30KB.";
+	EXPECT_EQ(allocation5.offset, 60_KB) << "Allocation 5 offset isn't 60KB.";
+
+	allocator.RelinquishMemory(allocation.offset, allocation.size);
+	allocator.RelinquishMemory(allocation2.offset, allocation2.size);
+	allocator.RelinquishMemory(allocation4.offset, allocation4.size);
+
+	const auto& availableMemory = SharedBufferAllocatorTest::GetAvailableMemory(allocator);
+
+	// The budget runs out in the middle of the first live range, so only a part of it is
+	// moved.
+	const std::vector<Callisto::DefragmentationMove> moves = allocator.Defragment(5_KB);
+
+	EXPECT_EQ(std::size(moves), 1u) << "Move count isn't 1.";
+	EXPECT_EQ(moves[0].srcOffset, 5_KB) << "Move src isn't 5KB.";
+	EXPECT_EQ(moves[0].dstOffset, 0u) << "Move dst isn't 0.";
+	EXPECT_EQ(moves[0].size, 5_KB) << "Move size isn't 5KB.";
+
+	EXPECT_EQ(std::size(availableMemory), 3u) << "Available block count isn't 3.";
+	EXPECT_EQ(availableMemory[0].offset, 5_KB) << "Available block 0 offset isn't 5KB.";
+	EXPECT_EQ(availableMemory[0].size, 5_KB) << "Available block 0 size isn't 5KB.";
+
+	// The rest of the first range is larger than the 5KB gap, so it is moved in gap sized
+	// pieces.
+	const std::vector<Callisto::DefragmentationMove> moves1 = allocator.Defragment(1_MB);
+
+	EXPECT_EQ(std::size(moves1), 3u) << "Move count isn't 3.";
+	EXPECT_EQ(moves1[0].srcOffset, 10_KB) << "Move 0 src isn't 10KB.";
+	EXPECT_EQ(moves1[0].dstOffset, 5_KB) << "Move 0 dst isn't 5KB.";
+	EXPECT_EQ(moves1[0].size, 5_KB) << "Move 0 size isn't 5KB.";
+	EXPECT_EQ(moves1[1].srcOffset, 15_KB) << "Move 1 src isn't 15KB.";
+	EXPECT_EQ(moves1[1].dstOffset, 10_KB) << "Move 1 dst isn't 10KB.";
+	EXPECT_EQ(moves1[1].size, 5_KB) << "Move 1 size isn't 5KB.";
+	EXPECT_EQ(moves1[2].srcOffset, 30_KB) << "Move 2 src isn't 30KB.";
+	EXPECT_EQ(moves1[2].dstOffset, 15_KB) << "Move 2 dst isn't 15KB.";
+	EXPECT_EQ(moves1[2].size, 10_KB) << "Move 2 size isn't 10KB.";
+
+	// Every free block should be merged into one.
+	EXPECT_EQ(std::size(availableMemory), 1u) << "Available block count isn't 1.";
+	EXPECT_EQ(availableMemory[0].offset, 25_KB) << "Available block 0 offset isn't 25KB.";
+	EXPECT_EQ(availableMemory[0].size, 35_KB) << "Available block 0 size isn't 35KB.";
+
+	EXPECT_TRUE(std::empty(allocator.Defragment(1_MB))) << "Moved with a single free block.";
+}
+
+TEST(SharedBufferAllocatorTest, DefragmentationMoveCountTest)
+{
+	Callisto::SharedBufferAllocator allocator{};
+
+	size_t bufferSize = 0u;
+
+	std::vector<Callisto::SharedBufferAllocator::AllocInfo> allocations{};
+
+	for (size_t index = 0u; index < 6u; ++index)
+		allocations.emplace_back(GetAllocation(allocator, bufferSize, 5_KB));
+
+	allocator.RelinquishMemory(allocations[0].offset, allocations[0].size);
+	allocator.RelinquishMemory(allocations[2].offset, allocations[2].size);
+	allocator.RelinquishMemory(allocations[4].offset, allocations[4].size);
+
+	const auto& availableMemory = SharedBufferAllocatorTest::GetAvailableMemory(allocator);
+
+	const std::vector<Callisto::DefragmentationMove> moves = allocator.Defragment(1_MB, 1u);
+
+	EXPECT_EQ(std::size(moves), 1u) << "Move count isn't 1.";
+	EXPECT_EQ(moves[0].srcOffset, 5_KB) << "Move src isn't 5KB.";
+	EXPECT_EQ(moves[0].dstOffset, 0u) << "Move dst isn't 0.";
+	EXPECT_EQ(std::size(availableMemory), 2u) << "Available block count isn't 2.";
+
+	const std::vector<Callisto::DefragmentationMove> moves1 = allocator.Defragment(1_MB, 1u);
+
+	EXPECT_EQ(std::size(moves1), 1u) << "Move count isn't 1.";
+	EXPECT_EQ(moves1[0].srcOffset, 15_KB) << "Move src isn't 15KB.";
+	EXPECT_EQ(moves1[0].dstOffset, 5_KB) << "Move dst isn't 5KB.";
+
+	EXPECT_EQ(std::size(availableMemory), 1u) << "Available block count isn't 1.";
+	EXPECT_EQ(availableMemory[0].offset, 10_KB) << "Available block 0 offset isn't 10KB.";
+	EXPECT_EQ(availableMemory[0].size, 15_KB) << "Available block 0 size isn't 15KB.";
+}
+
+TEST(SharedBufferAllocatorTest, DeferRelinquishTest)
+{
+	Callisto::SharedBufferAllocator allocator{};
+
+	size_t bufferSize = 0u;
+
+	const auto allocation  = GetAllocation(allocator, bufferSize, 5_KB);
+	const auto allocation1 = GetAllocation(allocator, bufferSize, 15_KB);
+	const auto allocation2 = GetAllocation(allocator, bufferSize, 10_KB);
+	const auto allocation3 = GetAllocation(allocator, bufferSize, 10_KB);
+
+	allocator.DeferRelinquish(allocation.offset, allocation.size, 1u);
+	allocator.DeferRelinquish(allocation2.offset, allocation2.size, 0u);
+	allocator.DeferRelinquish(allocation1.offset, allocation1.size, 1u);
+
+	const auto& availableMemory = SharedBufferAllocatorTest::GetAvailableMemory(allocator);
+
+	EXPECT_EQ(std::size(availableMemory), 0u) << "Available block count isn't 0.";
+
+	allocator.RetireFrame(1u);
+
+	EXPECT_EQ(std::size(availableMemory), 1u) << "Available block count isn't 1.";
+	EXPECT_EQ(availableMemory[0].offset, 0u) << "Available block 0 offset isn't 0.";
+	EXPECT_EQ(availableMemory[0].size, 20_KB) << "Available block 0 size isn't 20KB.";
+
+	// The frame 1 bucket should be empty now.
+	allocator.RetireFrame(1u);
+
+	EXPECT_EQ(std::size(availableMemory), 1u) << "Available block count isn't 1.";
+
+	allocator.RelinquishMemory(allocation3.offset, allocation3.size);
+
+	// The deferred memory of the frame 0 separates the free blocks, but it can't be moved.
+	EXPECT_TRUE(std::empty(allocator.Defragment(1_KB))) << "Moved deferred memory.";
+
+	allocator.RetireFrame(0u);
+
+	EXPECT_EQ(std::size(availableMemory), 1u) << "Available block count isn't 1.";
+	EXPECT_EQ(availableMemory[0].offset, 0u) << "Available block 0 offset isn't 0.";
+	EXPECT_EQ(availableMemory[0].size, 40_KB) << "Available block 0 size isn't 40KB.";
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <SnapshotReusableVector.hpp>
+#include <atomic>
+#include <thread>
+
+TEST(SnapshotReusableVectorTest, PublishTest)
+{
+	Callisto::SnapshotReusableVector<int, 4u> rVec{};
+
+	for (int value = 0; value < 10; ++value)
+		rVec.Add(value);
+
+	auto emptySnapshot = rVec.GetSnapshot();
+
+	EXPECT_EQ(std::size(*emptySnapshot), 0u) << "The first snapshot isn't empty.";
+
+	rVec.Publish();
+
+	auto snapshot = rVec.GetSnapshot();
+
+	EXPECT_EQ(std::size(*snapshot), 10u) << "Snapshot size isn't 10.";
+	EXPECT_EQ((*snapshot)[9], 9) << "Snapshot index 9 isn't 9.";
+
+	const int* firstPageElement  = &(*snapshot)[0];
+	const int* secondPageElement = &(*snapshot)[4];
+
+	// Only the first page should be copied.
+	rVec.Modify(1u) = 100;
+	rVec.RemoveElement(2u);
+
+	EXPECT_EQ(rVec[1], 100) << "RVec index 1 isn't 100.";
+	EXPECT_EQ((*snapshot)[1], 1) << "The snapshot was changed.";
+	EXPECT_TRUE(snapshot->IsInUse(2u)) << "The snapshot's index 2 isn't in use.";
+	EXPECT_NE(&rVec[0], firstPageElement) << "The shared page wasn't copied.";
+	EXPECT_EQ(&rVec[4], secondPageElement) << "An unchanged page was copied.";
+
+	rVec.Publish();
+
+	auto snapshot1 = rVec.GetSnapshot();
+
+	EXPECT_EQ((*snapshot1)[1], 100) << "Snapshot1 index 1 isn't 100.";
+	EXPECT_FALSE(snapshot1->IsInUse(2u)) << "Snapshot1 index 2 is in use.";
+
+	// Without any other snapshot holding it, the page shouldn't be copied again.
+	snapshot.reset();
+	snapshot1.reset();
+	rVec.Publish();
+
+	const int* publishedElement = &(*rVec.GetSnapshot())[0];
+
+	rVec.Modify(3u) = 300;
+
+	EXPECT_NE(&rVec[0], publishedElement) << "The published page wasn't copied.";
+
+	const int* workingElement = &rVec[0];
+
+	rVec.Modify(3u) = 301;
+
+	EXPECT_EQ(&rVec[0], workingElement) << "An unshared page was copied.";
+}
+
+TEST(SnapshotReusableVectorTest, ConcurrentReadTest)
+{
+	Callisto::SnapshotReusableVector<int, 64u> rVec{ 256u };
+
+	std::atomic_bool done{ false };
+
+	// Every element of a snapshot should have the same value, as they are all changed before
+	// publishing.
+	std::jthread reader{
+		[&rVec, &done]
+		{
+			while (!done.load())
+			{
+				auto snapshot = rVec.GetSnapshot();
+
+				for (size_t index = 1u; index < std::size(*snapshot); ++index)
+					ASSERT_EQ((*snapshot)[index], (*snapshot)[0]) << "Torn snapshot.";
+			}
+		}
+	};
+
+	for (int value = 1; value <= 200; ++value)
+	{
+		for (size_t index = 0u; index < std::size(rVec); ++index)
+			rVec.Modify(index) = value;
+
+		rVec.Publish();
+	}
+
+	done.store(true);
+	reader.join();
+
+	EXPECT_EQ((*rVec.GetSnapshot())[255], 200) << "Snapshot index 255 isn't 200.";
+}
@@ -0,0 +1,368 @@
+#include <gtest/gtest.h>
+
+#include <TemporaryDataBuffer.hpp>
+#include <TemporaryArena.hpp>
+#include <TemporaryDataReclaimer.hpp>
+#include <string>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(TemporaryDataBufferTest, GPUFrameTest)
+{
+	Callisto::TemporaryDataBufferGPU tempBuffer{};
+
+	auto data  = std::make_shared<int>(1);
+	auto data1 = std::make_shared<int>(2);
+	auto data2 = std::make_shared<int>(3);
+
+	std::weak_ptr<int> weakData  = data;
+	std::weak_ptr<int> weakData1 = data1;
+	std::weak_ptr<int> weakData2 = data2;
+
+	tempBuffer.Add(std::move(data));
+	tempBuffer.SetUsed(0u);
+
+	tempBuffer.Add(std::move(data1));
+	tempBuffer.SetUsed(1u);
+
+	// Added to the same frame again before it was cleared.
+	tempBuffer.Add(std::move(data2));
+	tempBuffer.SetUsed(0u);
+
+	tempBuffer.Clear(1u);
+
+	EXPECT_FALSE(weakData.expired()) << "Frame 0's first data was released.";
+	EXPECT_TRUE(weakData1.expired()) << "Frame 1's data wasn't released.";
+	EXPECT_FALSE(weakData2.expired()) << "Frame 0's second data was released.";
+
+	tempBuffer.Clear(0u);
+
+	EXPECT_TRUE(weakData.expired()) << "Frame 0's first data wasn't released.";
+	EXPECT_TRUE(weakData2.expired()) << "Frame 0's second data wasn't released.";
+
+	// The pending data shouldn't be released by any frame.
+	auto data3 = std::make_shared<int>(4);
+
+	std::weak_ptr<int> weakData3 = data3;
+
+	tempBuffer.Add(std::move(data3));
+	tempBuffer.Clear(0u);
+	tempBuffer.Clear(1u);
+	tempBuffer.Clear(5u);
+
+	EXPECT_FALSE(weakData3.expired()) << "Pending data was released.";
+
+	tempBuffer.SetUsed(1u);
+	tempBuffer.Clear(1u);
+
+	EXPECT_TRUE(weakData3.expired()) << "Frame 1's data wasn't released.";
+}
+
+TEST(TemporaryDataBufferTest, ArenaTest)
+{
+	struct Counter
+	{
+		Counter(size_t& destroyedCount) : m_destroyedCount{ destroyedCount } {}
+		~Counter() { ++m_destroyedCount; }
+
+		size_t& m_destroyedCount;
+	};
+
+	Callisto::TemporaryArena arena{ 256u };
+
+	size_t destroyedCount = 0u;
+
+	std::string* text = arena.Emplace<std::string>("A string which is too long for SSO.");
+	arena.Emplace<Counter>(destroyedCount);
+	arena.Emplace<Counter>(destroyedCount);
+
+	int* number = arena.Emplace<int>(5);
+
+	EXPECT_EQ(*text, "A string which is too long for SSO.") << "The string wasn't constructed.";
+	EXPECT_EQ(*number, 5) << "The number isn't 5.";
+
+	void* alignedMemory = arena.AllocateBytes(100u, 64u);
+
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(alignedMemory) % 64u, 0u)
+		<< "The memory isn't aligned to 64 bytes.";
+
+	// Larger than a chunk.
+	void* largeMemory = arena.AllocateBytes(1000u);
+
+	EXPECT_NE(largeMemory, nullptr) << "Couldn't allocate more than a chunk.";
+	EXPECT_GE(arena.GetAllocatedSize(), 1100u) << "Allocated size is less than 1100.";
+
+	Callisto::TemporaryArena arena1{ 256u };
+
+	arena1.Emplace<Counter>(destroyedCount);
+	arena.Splice(arena1);
+
+	EXPECT_TRUE(arena1.IsEmpty()) << "The spliced arena isn't empty.";
+
+	arena1.Reset();
+
+	EXPECT_EQ(destroyedCount, 0u) << "The spliced object was destroyed.";
+
+	arena.Reset();
+
+	EXPECT_EQ(destroyedCount, 3u) << "The objects weren't destroyed.";
+	EXPECT_TRUE(arena.IsEmpty()) << "The arena isn't empty.";
+}
+
+TEST(TemporaryDataBufferTest, ArenaLargeChunkTest)
+{
+	Callisto::TemporaryArena arena{ 256u };
+
+	void* memory = arena.AllocateBytes(100u);
+
+	EXPECT_NE(memory, nullptr) << "Couldn't allocate from the arena.";
+	EXPECT_EQ(arena.GetReservedSize(), 256u) << "Reserved size isn't a chunk.";
+
+	// Each of them gets a chunk of its own.
+	for (size_t index = 0u; index < 3u; ++index)
+		memory = arena.AllocateBytes(1024u * 1024u);
+
+	EXPECT_GE(arena.GetReservedSize(), 3u * 1024u * 1024u) << "The large chunks weren't counted.";
+
+	arena.Reset();
+
+	EXPECT_EQ(arena.GetReservedSize(), 256u) << "The large chunks weren't released.";
+
+	memory = arena.AllocateBytes(200u);
+
+	EXPECT_NE(memory, nullptr) << "Couldn't allocate after resetting.";
+	EXPECT_EQ(arena.GetReservedSize(), 256u) << "The normal chunk wasn't reused.";
+}
+
+TEST(TemporaryDataBufferTest, GPUArenaTest)
+{
+	Callisto::TemporaryDataBufferGPU tempBuffer{};
+
+	auto data = std::make_shared<int>(1);
+
+	std::weak_ptr<int> weakData = data;
+
+	int* number = tempBuffer.Emplace<int>(5);
+	auto* text  = tempBuffer.Emplace<std::string>("Frame 0");
+
+	tempBuffer.Add(std::move(data));
+	tempBuffer.SetUsed(0u);
+
+	tempBuffer.Emplace<std::string>("Frame 0 again");
+	tempBuffer.SetUsed(0u);
+
+	tempBuffer.Emplace<std::string>("Frame 1");
+	tempBuffer.SetUsed(1u);
+
+	tempBuffer.Clear(1u);
+
+	EXPECT_EQ(*number, 5) << "Frame 0's number was released.";
+	EXPECT_EQ(*text, "Frame 0") << "Frame 0's text was released.";
+
+	tempBuffer.Clear(0u);
+
+	EXPECT_TRUE(weakData.expired()) << "Frame 0's shared data wasn't released.";
+
+	Callisto::TemporaryDataBufferCPU tempBufferCPU{};
+
+	std::string* cpuText = tempBufferCPU.Emplace<std::string>("CPU");
+
+	EXPECT_EQ(*cpuText, "CPU") << "The CPU text wasn't constructed.";
+
+	tempBufferCPU.Clear();
+}
+
+TEST(TemporaryDataBufferTest, BackgroundReclaimTest)
+{
+	Callisto::TemporaryDataBufferGPU tempBuffer{};
+
+	tempBuffer.EnableBackgroundReclaim();
+
+	EXPECT_TRUE(tempBuffer.IsBackgroundReclaimEnabled()) << "Background reclaim isn't enabled.";
+
+	auto data = std::make_shared<int>(1);
+
+	std::weak_ptr<int> weakData = data;
+
+	tempBuffer.Add(std::move(data));
+	tempBuffer.Emplace<std::string>("A string which is too long for SSO.");
+	tempBuffer.SetUsed(0u);
+
+	tempBuffer.Clear(0u);
+	tempBuffer.Flush();
+
+	EXPECT_TRUE(weakData.expired()) << "Frame 0's data wasn't released after flushing.";
+	EXPECT_EQ(tempBuffer.GetReclaimingBytes(), 0u) << "Bytes are still being reclaimed.";
+
+	// The worker destroys the objects while the next frames are added.
+	std::atomic<size_t> destroyedCount = 0u;
+
+	struct Counter
+	{
+		Counter(std::atomic<size_t>& destroyedCount) : m_destroyedCount{ destroyedCount } {}
+		~Counter() { m_destroyedCount.fetch_add(1u); }
+
+		std::atomic<size_t>& m_destroyedCount;
+	};
+
+	for (size_t frameIndex = 0u; frameIndex < 300u; ++frameIndex)
+	{
+		tempBuffer.Emplace<Counter>(destroyedCount);
+		tempBuffer.SetUsed(frameIndex % 3u);
+		tempBuffer.Clear((frameIndex + 1u) % 3u);
+	}
+
+	tempBuffer.Clear(0u);
+	tempBuffer.Clear(1u);
+	tempBuffer.Clear(2u);
+	tempBuffer.Flush();
+
+	EXPECT_EQ(destroyedCount.load(), 300u) << "Not every object was destroyed.";
+
+	// Nothing can be outstanding, so every bucket is destroyed in Clear.
+	Callisto::TemporaryDataReclaimer reclaimer{ 0u };
+
+	Callisto::TemporaryDataBucket bucket{};
+
+	bucket.arena.Emplace<Counter>(destroyedCount);
+
+	reclaimer.Reclaim(std::move(bucket));
+
+	EXPECT_EQ(destroyedCount.load(), 301u) << "The bucket over the bound wasn't destroyed.";
+	EXPECT_EQ(reclaimer.GetOutstandingBytes(), 0u) << "There are outstanding bytes.";
+
+	tempBuffer.DisableBackgroundReclaim();
+
+	EXPECT_FALSE(tempBuffer.IsBackgroundReclaimEnabled()) << "Background reclaim is enabled.";
+}
+
+TEST(TemporaryDataBufferTest, MultiProducerAddTest)
+{
+	static constexpr size_t s_threadCount   = 4u;
+	static constexpr size_t s_addsPerThread = 1000u;
+
+	Callisto::TemporaryDataBufferGPU tempBuffer{};
+	Callisto::TemporaryDataBufferCPU tempBufferCPU{};
+
+	std::atomic<size_t> releasedCount = 0u;
+
+	auto makeData = [&releasedCount]
+	{
+		return std::shared_ptr<int>{
+			new int{ 0 }, [&releasedCount](int* data) { delete data; releasedCount.fetch_add(1u); }
+		};
+	};
+
+	{
+		std::vector<std::jthread> loaders{};
+
+		for (size_t threadIndex = 0u; threadIndex < s_threadCount; ++threadIndex)
+			loaders.emplace_back(
+				[&]
+				{
+					for (size_t index = 0u; index < s_addsPerThread; ++index)
+					{
+						tempBuffer.Add(makeData());
+						tempBufferCPU.Add(makeData());
+					}
+				}
+			);
+
+		// SetUsed is called while the loaders are still adding.
+		for (size_t frameIndex = 0u; frameIndex < 100u; ++frameIndex)
+			tempBuffer.SetUsed(frameIndex % 2u);
+	}
+
+	EXPECT_EQ(releasedCount.load(), 0u) << "Some data was released before clearing.";
+
+	tempBuffer.SetUsed(0u);
+	tempBuffer.Clear(0u);
+	tempBuffer.Clear(1u);
+
+	EXPECT_EQ(releasedCount.load(), s_threadCount * s_addsPerThread)
+		<< "Not every GPU data was released.";
+
+	tempBufferCPU.Clear();
+
+	EXPECT_EQ(releasedCount.load(), 2u * s_threadCount * s_addsPerThread)
+		<< "Not every CPU data was released.";
+}
+
+TEST(TemporaryDataBufferTest, ByteAccountingTest)
+{
+	static constexpr size_t s_chunkSize = Callisto::TemporaryArena::s_defaultChunkSize;
+
+	Callisto::TemporaryDataBufferGPU tempBuffer{};
+
+	size_t failedByteSize = 0u;
+
+	auto budgetCallback = [&failedByteSize](size_t, size_t byteSize)
+	{
+		failedByteSize = byteSize;
+	};
+
+	tempBuffer.SetBudget(1000u, budgetCallback);
+
+	tempBuffer.Add(std::make_shared<int>(1), 400u);
+
+	EXPECT_TRUE(tempBuffer.TryAdd(std::make_shared<int>(2), 500u))
+		<< "Couldn't add under the budget.";
+	EXPECT_EQ(tempBuffer.GetTotalHeldBytes(), 900u) << "Total held bytes isn't 900.";
+
+	tempBuffer.SetUsed(0u);
+
+	EXPECT_EQ(tempBuffer.GetHeldBytes(0u), 900u) << "Frame 0's held bytes isn't 900.";
+
+	EXPECT_FALSE(tempBuffer.TryAdd(std::make_shared<int>(3), 200u)) << "Added over the budget.";
+	EXPECT_EQ(failedByteSize, 200u) << "The budget callback wasn't called.";
+
+	// The arena would need a whole chunk.
+	EXPECT_EQ(tempBuffer.TryAllocateBytes(64u), nullptr) << "Allocated over the budget.";
+	EXPECT_EQ(failedByteSize, s_chunkSize) << "The arena chunk wasn't checked.";
+
+	EXPECT_EQ(tempBuffer.TryEmplace<int>(5), nullptr) << "Emplaced over the budget.";
+
+	tempBuffer.SetBudget(4u * 1024u * 1024u, budgetCallback);
+
+	void* memory = tempBuffer.TryAllocateBytes(64u);
+
+	EXPECT_NE(memory, nullptr) << "Couldn't allocate under the budget.";
+
+	tempBuffer.SetUsed(1u);
+
+	EXPECT_EQ(tempBuffer.GetHeldBytes(1u), s_chunkSize) << "Frame 1's chunk wasn't counted.";
+
+	// Each of them gets a chunk of its own, which should be released when the frame is
+	// cleared.
+	for (size_t index = 0u; index < 3u; ++index)
+		memory = tempBuffer.AllocateBytes(512u * 1024u);
+
+	tempBuffer.SetUsed(1u);
+
+	EXPECT_GE(tempBuffer.GetHeldBytes(1u), s_chunkSize + 3u * 512u * 1024u)
+		<< "The large chunks weren't counted.";
+	EXPECT_EQ(
+		tempBuffer.GetTotalHeldBytes(), tempBuffer.GetHeldBytes(0u) + tempBuffer.GetHeldBytes(1u)
+	) << "Total held bytes isn't the sum of the frames.";
+
+	tempBuffer.Clear(1u);
+
+	EXPECT_EQ(tempBuffer.GetHeldBytes(1u), s_chunkSize) << "Only the normal chunk should be kept.";
+
+	tempBuffer.Clear(0u);
+
+	EXPECT_EQ(tempBuffer.GetHeldBytes(0u), 0u) << "Frame 0 still holds bytes.";
+	EXPECT_EQ(tempBuffer.GetTotalHeldBytes(), s_chunkSize) << "Total held bytes isn't a chunk.";
+
+	// The paths which can't fail still call the callback.
+	tempBuffer.SetBudget(1000u, budgetCallback);
+
+	failedByteSize = 0u;
+
+	int* number    = tempBuffer.Emplace<int>(5);
+
+	EXPECT_EQ(*number, 5) << "The number wasn't emplaced.";
+	EXPECT_EQ(failedByteSize, s_chunkSize) << "The budget callback wasn't called for Emplace.";
+}
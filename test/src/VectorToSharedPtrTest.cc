@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <VectorToSharedPtr.hpp>
+#include <array>
+#include <span>
+#include <cstring>
+
+TEST(VectorToSharedPtrTest, CopyTest)
+{
+	const std::vector<int> items{ 1, 2, 3, 4 };
+
+	auto vectorBuffer = Callisto::CopyVectorToSharedPtr(items);
+
+	EXPECT_NE(reinterpret_cast<const int*>(vectorBuffer.get()), std::data(items))
+		<< "The vector wasn't copied.";
+	EXPECT_EQ(std::memcmp(vectorBuffer.get(), std::data(items), sizeof(int) * 4u), 0)
+		<< "The vector copy is different.";
+
+	auto explicitBuffer = Callisto::CopyVectorToSharedPtr<int>(items);
+
+	EXPECT_EQ(std::memcmp(explicitBuffer.get(), std::data(items), sizeof(int) * 4u), 0)
+		<< "The copy with the explicit type is different.";
+
+	std::array<float, 3u> floats{ 1.f, 2.f, 3.f };
+
+	auto spanBuffer = Callisto::CopyVectorToSharedPtr(std::span<float>{ floats });
+
+	EXPECT_EQ(std::memcmp(spanBuffer.get(), std::data(floats), sizeof(float) * 3u), 0)
+		<< "The span copy is different.";
+
+	auto arrayBuffer = Callisto::CopyVectorToSharedPtr(floats);
+
+	EXPECT_EQ(std::memcmp(arrayBuffer.get(), std::data(floats), sizeof(float) * 3u), 0)
+		<< "The array copy is different.";
+
+	const std::uint16_t cArray[2]{ 5u, 6u };
+
+	auto cArrayBuffer = Callisto::CopyVectorToSharedPtr(cArray);
+
+	EXPECT_EQ(std::memcmp(cArrayBuffer.get(), cArray, sizeof(cArray)), 0)
+		<< "The C array copy is different.";
+}
+
+TEST(VectorToSharedPtrTest, MoveTest)
+{
+	std::vector<int> items{ 1, 2, 3, 4 };
+
+	const int* itemData = std::data(items);
+
+	auto buffer = Callisto::MoveVectorToSharedPtr(std::move(items));
+
+	EXPECT_EQ(reinterpret_cast<const int*>(buffer.get()), itemData)
+		<< "The vector's storage wasn't adopted.";
+	EXPECT_TRUE(std::empty(items)) << "The vector wasn't moved.";
+	EXPECT_EQ(reinterpret_cast<const int*>(buffer.get())[3], 4) << "Index 3 isn't 4.";
+
+	// The copies share the owner, so the data must be alive until the last one is released.
+	std::weak_ptr<std::uint8_t[]> weakBuffer   = buffer;
+	std::shared_ptr<std::uint8_t[]> bufferCopy = buffer;
+
+	buffer.reset();
+
+	EXPECT_FALSE(weakBuffer.expired()) << "The data was released with an owner left.";
+	EXPECT_EQ(reinterpret_cast<const int*>(bufferCopy.get())[0], 1) << "Index 0 isn't 1.";
+
+	bufferCopy.reset();
+
+	EXPECT_TRUE(weakBuffer.expired()) << "The data wasn't released with the last owner.";
+}